@@ -1,36 +1,77 @@
 #include "binarytree.h"
+#include "treewalk.h"
+#include "forkjoin.h"
 #include <QtMath>
 
+static_assert((quint64(1) << BinaryTree::kMaxPointerHeight) - 1 <= NodeArena::kMaxNodes,
+              "满二叉树的结点数不能超过 NodeArena 的槽位号范围");
+
 
 BinaryTree::~BinaryTree()
 {
     clear();
 }
 
+// 结点都在 m_arena 里：不必逐个遍历释放，也不用先拆线索
 void BinaryTree::clear()
 {
-    destroy(m_root);
+    m_arena.releaseAll();
     m_root = nullptr;
+    m_implicit = ImplicitFullTree();
+    m_threading = Threading::None;
 }
 
-void BinaryTree::destroy(ThreadedNode* p)
+int BinaryTree::threadCount() const
 {
-    if (!p) return;
+    return m_threads > 0 ? m_threads : ForkJoin::defaultThreads();
+}
 
-    // 先把线索恢复为空，避免把线索当孩子递归
-    if (p->ltag == ThreadedNode::Thread) p->left  = nullptr;
-    if (p->rtag == ThreadedNode::Thread) p->right = nullptr;
+ThreadedNode* BinaryTree::root()
+{
+    if (isImplicit()) materialize();
+    return m_root;
+}
 
-    destroy(p->left);
-    destroy(p->right);
-    delete p;
+// 隐式 -> 指针：按同样的先序编号建出结点，再补做记录下来的线索化
+void BinaryTree::materialize()
+{
+    const int height = m_implicit.height();
+    if (height > kMaxPointerHeight) return;      // 指针形态放不下，保持隐式（root() 为空）
+    const Threading thread = m_threading;
+    m_implicit = ImplicitFullTree();
+    m_threading = Threading::None;
+
+    buildFullByHeight(height, Backend::Pointer);
+    switch (thread) {
+    case Threading::Pre:  makePreorderThread();  break;
+    case Threading::In:   makeInorderThread();   break;
+    case Threading::Post: makePostorderThread(); break;
+    case Threading::None: break;
+    }
 }
 
+void BinaryTree::implicitWalk(quint64 first, quint64 (ImplicitFullTree::*next)(quint64) const,
+                              TraversalSink& sink) const
+{
+    for (quint64 i = first; i != ImplicitFullTree::kNone; i = (m_implicit.*next)(i))
+        sink.value(m_implicit.value(i));
+}
 
-ThreadedNode* BinaryTree::buildFullByHeight(int height)
+
+ThreadedNode* BinaryTree::buildFullByHeight(int height, Backend backend)
 {
     clear();
     if (height <= 0) return m_root;      // 空树
+    if (backend == Backend::Implicit) {  // O(1)：只记层高
+        if (height > kMaxImplicitHeight) return nullptr;
+        m_implicit = ImplicitFullTree(height);
+        return nullptr;
+    }
+    if (height > kMaxPointerHeight) return nullptr;   // 再大 id 就会回绕，旁路表的行相互覆盖
+    if (height >= kParallelHeight && threadCount() > 1) {
+        m_root = ParallelTree::buildFull(m_arena, height, threadCount());
+        return m_root;
+    }
     int nextVal = 1;                     // 给节点编号，便于 UI 展示
     m_root = buildFullRec(/*curr*/1, height, /*parent*/nullptr, nextVal);
     return m_root;
@@ -40,7 +81,7 @@ ThreadedNode* BinaryTree::buildFullRec(int curr, int max, ThreadedNode* parent,
 {
     if (curr > max) return nullptr;
 
-    auto* node = new ThreadedNode(nextVal++, parent);
+    auto* node = m_arena.create(nextVal++, parent);
 
     // 满二叉树：除最后一层外必有左右孩子
     node->setLeftChild ( buildFullRec(curr + 1, max, node, nextVal) );
@@ -53,64 +94,80 @@ ThreadedNode* BinaryTree::buildFullRec(int curr, int max, ThreadedNode* parent,
 // 叶子计数
 int BinaryTree::leafCount() const
 {
-    return leafCountRec(m_root);
-}
-
-int BinaryTree::leafCountRec(ThreadedNode* p) const
-{
-    if (!p) return 0;
-    if (p->isLeaf()) return 1;
-    // 注意：线索不算孩子
-    int l = (p->ltag == ThreadedNode::Child) ? leafCountRec(p->left)  : 0;
-    int r = (p->rtag == ThreadedNode::Child) ? leafCountRec(p->right) : 0;
-    return l + r;
+    if (isImplicit()) return int(m_implicit.leafCount());
+    if (parallel()) return int(ParallelTree::leafCount(m_root, threadCount()));
+    int count = 0;                       // 线索不算孩子
+    TreeWalk::preorder(m_root, [&](ThreadedNode* p){
+        if (!TreeWalk::leftChild(p) && !TreeWalk::rightChild(p)) ++count;
+    });
+    return count;
 }
 
-// 普通递归遍历 
-QString BinaryTree::preorder() const
+// 遍历输出
+void BinaryTree::write(Order order, TraversalSink& sink) const
 {
-    QString out;
-    preorderRec(m_root, out);
-    return out.trimmed();
-}
-
-QString BinaryTree::inorder() const
-{
-    QString out;
-    inorderRec(m_root, out);
-    return out.trimmed();
+    auto put = [&](ThreadedNode* p){ sink.value(p->value); };
+    if (isImplicit()) {
+        // 隐式满二叉树的线索就是各序的前驱后继，线索遍历与普通遍历结果相同
+        switch (order) {
+        case Order::Pre:
+        case Order::PreThreaded:         // 结点值就是先序编号：沿先序逐个加一，不必按下标推算
+            for (quint64 v = 1; v <= m_implicit.size(); ++v) sink.value(int(v));
+            break;
+        case Order::In:
+        case Order::InThreaded:          // 中序第 k 个就是名次 k，直接按名次取下标
+            for (quint64 k = 1; k <= m_implicit.size(); ++k) sink.value(m_implicit.value(m_implicit.nodeAtInorder(k)));
+            break;
+        case Order::Post:
+        case Order::PostThreaded: implicitWalk(m_implicit.postorderFirst(), &ImplicitFullTree::postorderNext, sink); break;
+        }
+    } else {
+        switch (order) {
+        case Order::Pre:
+            if (m_strategy == Strategy::Morris) TreeWalk::morrisPreorder(m_root, put);
+            else                                TreeWalk::preorder(m_root, put);
+            break;
+        case Order::In:
+            if (m_strategy == Strategy::Morris) TreeWalk::morrisInorder(m_root, put);
+            else                                TreeWalk::inorder(m_root, put);
+            break;
+        case Order::Post:         TreeWalk::postorder(m_root, put); break;
+        case Order::PreThreaded:  preorderThreadedWalk(sink);       break;
+        case Order::InThreaded:   inorderThreadedWalk(sink);        break;
+        case Order::PostThreaded: postorderThreadedWalk(sink);      break;
+        }
+    }
+    sink.finish();
 }
 
-QString BinaryTree::postorder() const
+QString BinaryTree::toText(Order order) const
 {
     QString out;
-    postorderRec(m_root, out);
-    return out.trimmed();
-}
-
-void BinaryTree::preorderRec(ThreadedNode* p, QString& out) const
-{
-    if (!p) return;
-    out += QString::number(p->value) + ' ';
-    if (p->ltag == ThreadedNode::Child) preorderRec(p->left,  out);
-    if (p->rtag == ThreadedNode::Child) preorderRec(p->right, out);
+    StringSink sink(out);
+    write(order, sink);
+    return out;
 }
 
-void BinaryTree::inorderRec(ThreadedNode* p, QString& out) const
+std::vector<int> BinaryTree::sequence(Order order) const
 {
-    if (!p) return;
-    if (p->ltag == ThreadedNode::Child) inorderRec(p->left,  out);
-    out += QString::number(p->value) + ' ';
-    if (p->rtag == ThreadedNode::Child) inorderRec(p->right, out);
+    std::vector<int> out;
+    if (!isImplicit() && parallel()
+        && (order == Order::Pre || order == Order::In || order == Order::Post)) {
+        const ParallelTree::Order po = order == Order::Pre ? ParallelTree::Order::Pre
+                                     : order == Order::In  ? ParallelTree::Order::In
+                                                           : ParallelTree::Order::Post;
+        ParallelTree::sequence(m_root, po, threadCount(), out);
+        return out;
+    }
+    out.reserve(size_t(isImplicit() ? m_implicit.size() : quint64(m_arena.liveCount())));
+    CallbackSink sink([&](int v){ out.push_back(v); });
+    write(order, sink);
+    return out;
 }
 
-void BinaryTree::postorderRec(ThreadedNode* p, QString& out) const
-{
-    if (!p) return;
-    if (p->ltag == ThreadedNode::Child) postorderRec(p->left,  out);
-    if (p->rtag == ThreadedNode::Child) postorderRec(p->right, out);
-    out += QString::number(p->value) + ' ';
-}
+QString BinaryTree::preorder()  const { return toText(Order::Pre);  }
+QString BinaryTree::inorder()   const { return toText(Order::In);   }
+QString BinaryTree::postorder() const { return toText(Order::Post); }
 
 // 线索化
 // 线索化的统一原则：在“访问到当前结点 p”时：
@@ -118,120 +175,59 @@ void BinaryTree::postorderRec(ThreadedNode* p, QString& out) const
 //  2) 如果 pre 不为空且 pre->right 为空，则让 pre->right 指向“本遍历序的后继 p”，并置 pre->rtag=Thread；
 //  3) 最后 pre = p；
 // 遍历序（先/中/后）不同，得到的前驱/后继关系不同，这正是“线索化”的本质。
-
-void BinaryTree::clearThreadsRec(ThreadedNode* p)
-{
-    if (!p) return;
-    p->clearThreads(); // 只清本节点的线索标记与指针
-    if (p->ltag == ThreadedNode::Child) clearThreadsRec(p->left);
-    if (p->rtag == ThreadedNode::Child) clearThreadsRec(p->right);
-}
-
-void BinaryTree::preorderThreadRec(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    // —— 访问 p（先序）——
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-
-    if (p->ltag == ThreadedNode::Child) preorderThreadRec(p->left, pre);
-    if (p->rtag == ThreadedNode::Child) preorderThreadRec(p->right, pre);
-}
-
-void BinaryTree::inorderThreadRec(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    if (p->ltag == ThreadedNode::Child) inorderThreadRec(p->left, pre);
-
-    // —— 访问 p（中序）——
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-
-    if (p->rtag == ThreadedNode::Child) inorderThreadRec(p->right, pre);
-}
-
-void BinaryTree::postorderThreadRec(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    if (p->ltag == ThreadedNode::Child) postorderThreadRec(p->left, pre);
-    if (p->rtag == ThreadedNode::Child) postorderThreadRec(p->right, pre);
-
-    // —— 访问 p（后序）——
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-}
+// 上述原则即 TreeWalk::threadVisit，下面只决定按哪种顺序去访问。
 
 void BinaryTree::makePreorderThread()
 {
-    if (!m_root) return;
-    clearThreadsRec(m_root);               // 清理旧线索
+    m_threading = Threading::Pre;
+    if (isImplicit() || !m_root) return;
+    if (parallel()) { ParallelTree::thread(m_root, ParallelTree::Order::Pre, threadCount()); return; }
+    ThreadedNode::ClearAllThreads(m_root);               // 清理旧线索
     ThreadedNode* pre = nullptr;
-    preorderThreadRec(m_root, pre);
+    TreeWalk::preorder(m_root, [&](ThreadedNode* p){ TreeWalk::threadVisit(p, pre); });
 }
 
 void BinaryTree::makeInorderThread()
 {
-    if (!m_root) return;
-    clearThreadsRec(m_root);
+    m_threading = Threading::In;
+    if (isImplicit() || !m_root) return;
+    if (parallel()) { ParallelTree::thread(m_root, ParallelTree::Order::In, threadCount()); return; }
+    ThreadedNode::ClearAllThreads(m_root);
     ThreadedNode* pre = nullptr;
-    inorderThreadRec(m_root, pre);
+    TreeWalk::inorder(m_root, [&](ThreadedNode* p){ TreeWalk::threadVisit(p, pre); });
 }
 
 void BinaryTree::makePostorderThread()
 {
-    if (!m_root) return;
-    clearThreadsRec(m_root);
+    m_threading = Threading::Post;
+    if (isImplicit() || !m_root) return;
+    if (parallel()) { ParallelTree::thread(m_root, ParallelTree::Order::Post, threadCount()); return; }
+    ThreadedNode::ClearAllThreads(m_root);
     ThreadedNode* pre = nullptr;
-    postorderThreadRec(m_root, pre);
+    TreeWalk::postorder(m_root, [&](ThreadedNode* p){ TreeWalk::threadVisit(p, pre); });
 }
 
 // 线索遍历
-// 中序线索遍历：从整棵树的“最左”开始，依次按“线索后继/右子树最左”推进
-QString BinaryTree::inorderThreadedWalk() const
+QString BinaryTree::inorderThreadedWalk()  const { return toText(Order::InThreaded);  }
+QString BinaryTree::preorderThreadedWalk() const { return toText(Order::PreThreaded); }
+QString BinaryTree::postorderThreadedWalk() const { return toText(Order::PostThreaded); }
+
+// 三种线索遍历的推进规则都在 TraversalIterator 里：
+//    中序：线索后继，或右子树最左；先序：有左孩子走左孩子，否则右指针（右孩子或线索后继）；
+//    后序：右线索，或借 parent 找父结点/父结点右子树的后序第一个（O(n) 总计，不用栈）。
+void BinaryTree::inorderThreadedWalk(TraversalSink& sink) const
 {
-    if (!m_root) return {};
-    QString out;
-
-    const ThreadedNode* p = m_root->firstInorder();
-    while (p) {
-        out += QString::number(p->value) + ' ';
-
-        if (p->rtag == ThreadedNode::Thread) {
-            p = p->right;                 // 线索后继
-        } else {
-            if (!p->right) break;
-            const ThreadedNode* q = p->right;
-            while (q && q->ltag == ThreadedNode::Child && q->left)
-                q = q->left;              // 右子树的最左
-            p = q;
-        }
-    }
-    return out.trimmed();
+    for (ThreadedNode* p : Traversal(m_root, Order::InThreaded)) sink.value(p->value);
 }
 
-// 先序线索遍历
-//    访问 p -> 如果有“左孩子”，下一步到左孩子；否则“右指针”就是下一步（要么是右孩子，要么是线索后继）。
-QString BinaryTree::preorderThreadedWalk() const
+void BinaryTree::preorderThreadedWalk(TraversalSink& sink) const
 {
-    if (!m_root) return {};
-    QString out;
+    for (ThreadedNode* p : Traversal(m_root, Order::PreThreaded)) sink.value(p->value);
+}
 
-    const ThreadedNode* p = m_root;
-    while (p) {
-        out += QString::number(p->value) + ' ';
-        if (p->ltag == ThreadedNode::Child && p->left) {
-            p = p->left;
-        } else {
-            p = p->right; // 可能是右孩子，也可能是线索后继（我们在线索化时已把“无右孩子”的情况接成后继）
-        }
-    }
-    return out.trimmed();
+void BinaryTree::postorderThreadedWalk(TraversalSink& sink) const
+{
+    for (ThreadedNode* p : Traversal(m_root, Order::PostThreaded)) sink.value(p->value);
 }
 
 // 删除叶子
@@ -242,10 +238,53 @@ bool BinaryTree::removeLeaf(ThreadedNode* n)
 
     ThreadedNode* p = n->parent;
     if (!p) {  // 根且是唯一节点
-        delete n; m_root = nullptr; return true;
+        m_arena.destroy(n); m_root = nullptr; return true;
     }
-    if (p->left == n)  p->left = nullptr;
-    if (p->right == n) p->right = nullptr;
-    delete n;
+    if (m_threading != Threading::None) {
+        unlinkThreaded(n);
+    } else {
+        if (p->left == n)  p->left = nullptr;
+        if (p->right == n) p->right = nullptr;
+    }
+    m_arena.destroy(n);
     return true;
 }
+
+// 序列里去掉 n 只影响两处：n 的前驱 pred 与后继 succ 变成相邻；父结点 p 原来指向 n 的一侧空出来，
+// 按线索化原则补成 p 在新序列里的前驱（左侧）或后继（右侧）。其余结点的前驱后继都不变。
+// n 是叶子，左指针必是前驱线索（可能为空），右指针是后继线索或空（n 为最后一个）。
+void BinaryTree::unlinkThreaded(ThreadedNode* n)
+{
+    ThreadedNode* p    = n->parent;
+    ThreadedNode* pred = n->left;
+    ThreadedNode* succ = n->rtag == ThreadedNode::Thread ? n->right : nullptr;
+    const bool wasLeft = TreeWalk::leftChild(p) && p->left == n;
+
+    if (pred && pred->rtag == ThreadedNode::Thread && pred->right == n) {
+        if (succ) pred->right = succ;
+        else      { pred->right = nullptr; pred->rtag = ThreadedNode::Child; }
+    }
+    if (succ && succ->ltag == ThreadedNode::Thread && succ->left == n)
+        succ->left = pred;
+
+    if (wasLeft) {
+        ThreadedNode* before = nullptr;
+        switch (m_threading) {
+        case Threading::Pre:  before = p->preorderPredecessor(); break;         // n 在 p 之后，p 的前驱不变
+        case Threading::In:   before = pred; break;                             // pred, n, p
+        case Threading::Post: before = TreeWalk::rightChild(p) ? p->right : pred; break;
+        case Threading::None: break;
+        }
+        p->setLeftThread(before);
+    } else {
+        ThreadedNode* after = nullptr;
+        switch (m_threading) {
+        case Threading::Pre:  after = TreeWalk::leftChild(p) ? p->left : succ; break;
+        case Threading::In:   after = succ; break;                              // p, n, succ
+        case Threading::Post: after = p->postorderSuccessor(); break;           // n 在 p 之前，p 的后继不变
+        case Threading::None: break;
+        }
+        if (after) p->setRightThread(after);
+        else       { p->right = nullptr; p->rtag = ThreadedNode::Child; }
+    }
+}
@@ -5,14 +5,24 @@
 #include <QString>
 #include <vector>
 #include "threadednode.h"
+#include "nodearena.h"
+#include "implicittree.h"
+#include "traversalsink.h"
+#include "paralleltree.h"
+#include "traversaliterator.h"
 
 /**
  * 纯“数据结构层”的二叉树：
  * - buildFullByHeight(h): 依据层高建立满二叉树（h>=1）
- * - clear(): 释放整棵树
- * - 遍历：先/中/后序（递归），返回 QString（便于 UI 显示）
+ * - clear(): 释放整棵树（结点来自 NodeArena，整块归还）
+ * - 遍历：先/中/后序（非递归，沿 parent 指针走，任意深度不爆栈）；
+ *   write() 把结果逐个交给 TraversalSink（可写文件、回调、计数），返回 QString 的版本只是包装
  * - leafCount(): 叶子结点数（不把线索当孩子）
- * - 线索化：先/中/后序；并提供中序与先序的线索遍历
+ * - 线索化：先/中/后序；并提供对应的三种线索遍历
+ * 大树（层高 >= kParallelHeight 的建树、结点数 >= kParallelNodes 的计数/线索化/取序列）
+ * 自动切成子树并行处理（ParallelTree），setThreads(1) 退回串行。
+ * 两种存储：默认为指针结点；buildFullByHeight(h, Backend::Implicit) 只记层高，
+ * 遍历、计数按下标推算，直到第一次调用 root()（界面绘制、删叶子要结点指针）才转换成指针形式。
  */
 class BinaryTree
 {
@@ -20,10 +30,26 @@ public:
     BinaryTree() = default;
     ~BinaryTree();
 
-    ThreadedNode* root() const { return m_root; }
+    enum class Backend { Pointer, Implicit };
 
-    // 依据层高建立满二叉树；会自动清空旧树
-    ThreadedNode* buildFullByHeight(int height);
+    static constexpr int    kParallelHeight = 16;
+    static constexpr qint64 kParallelNodes  = qint64(1) << 16;
+    static constexpr int    kMaxPointerHeight  = 30;  // 2^30 - 1 个结点，槽位号恰好放得进 30 位 id
+    static constexpr int    kMaxImplicitHeight = ImplicitFullTree::kMaxHeight;
+
+    // 并行线程数；0 表示按硬件线程数
+    void setThreads(int n) { m_threads = n; }
+    int  threadCount() const;
+
+    // 隐式形态下先转换成指针形态再返回（层高超过 kMaxPointerHeight 时无法转换，返回 nullptr）
+    ThreadedNode* root();
+    bool isImplicit() const { return !m_implicit.isEmpty(); }
+    // 存储占用：指针形态为结点池已申请的块，隐式形态只有 ImplicitFullTree 本身
+    qint64 storageBytes() const { return isImplicit() ? qint64(sizeof(m_implicit)) : m_arena.reservedBytes(); }
+
+    // 依据层高建立满二叉树；会自动清空旧树（隐式形态返回 nullptr）。
+    // 层高超出所选形态的上限（kMaxPointerHeight / kMaxImplicitHeight）时不建树，树保持为空
+    ThreadedNode* buildFullByHeight(int height, Backend backend = Backend::Pointer);
 
     // 清空整棵树
     void clear();
@@ -31,12 +57,34 @@ public:
     // 统计叶子数（真实孩子，线索不算孩子）
     int leafCount() const;
 
-    // —— 普通递归遍历（不依赖线索） ——
+    using Order = TraversalOrder;
+
+    // 普通先序/中序的走法：沿 parent 回溯，或 Morris（借空 right 临时连回祖先，遍历中途会临时改动结点，
+    // 结束后复原）；后序和线索遍历不受影响。
+    // 注意：Morris 遍历期间结点的 right / rtag / parent 是临时值，虽然 write() 等是 const，
+    // 选了 Morris 后同一棵树不能被两个线程同时遍历，sink 回调里也不能顺着这几个字段去读树
+    enum class Strategy { ParentWalk, Morris };
+    void     setStrategy(Strategy s) { m_strategy = s; }
+    Strategy strategy() const        { return m_strategy; }
+
+    // 按 order 遍历，每个结点值交给 sink，结束时调用 sink.finish()；
+    // Strategy::Morris 下的 Pre/In 会临时改写结点（见 setStrategy），不可与其他读者并发
+    void write(Order order, TraversalSink& sink) const;
+    // 整个序列放进数组；大树的先/中/后序按子树并行填写
+    std::vector<int> sequence(Order order) const;
+    // 惰性遍历：for (ThreadedNode* p : tree.traverse(order))，逐个取结点，不收集整个序列
+    //（隐式形态下会先转换成指针形态）
+    Traversal traverse(Order order) { return Traversal(root(), order); }
+
+    // —— 普通遍历（不依赖线索） ——
     QString preorder()  const;
     QString inorder()   const;
     QString postorder() const;
 
     // —— 线索化：会把“空指针”按给定遍历序补为 前驱/后继 线索 ——
+    enum class Threading { None, Pre, In, Post };
+    Threading threading() const { return m_threading; }   // 最近一次线索化的顺序（建树后为 None）
+
     void makePreorderThread();   // 先序线索化
     void makeInorderThread();    // 中序线索化
     void makePostorderThread();  // 后序线索化
@@ -44,31 +92,32 @@ public:
     // —— 线索遍历（非递归） ——
     QString inorderThreadedWalk()  const;  // 中序线索遍历
     QString preorderThreadedWalk() const;  // 先序线索遍历（简单可靠）
+    QString postorderThreadedWalk() const; // 后序线索遍历（线索 + parent）
 
-    // 删除叶子（真实孩子意义上的叶子）
+    // 删除叶子（真实孩子意义上的叶子）；树已按 threading() 线索化时就地修补线索，O(树高)
     bool removeLeaf(ThreadedNode* n);
 
 private:
     ThreadedNode* m_root = nullptr;
-
-    // 释放整棵树
-    void destroy(ThreadedNode* p);
+    NodeArena     m_arena;             // 全部结点的来源；clear() 时整块释放
+    Strategy      m_strategy = Strategy::ParentWalk;
+    int           m_threads  = 0;
+    bool          parallel() const { return m_arena.liveCount() >= kParallelNodes && threadCount() > 1; }
+
+    // 隐式形态：线索不存，只记下最后一次线索化的顺序（m_threading），转换时补做
+    ImplicitFullTree m_implicit;
+    Threading        m_threading = Threading::None;
+    void materialize();
+    void implicitWalk(quint64 first, quint64 (ImplicitFullTree::*next)(quint64) const,
+                      TraversalSink& sink) const;
+    void inorderThreadedWalk (TraversalSink& sink) const;
+    void preorderThreadedWalk(TraversalSink& sink) const;
+    void postorderThreadedWalk(TraversalSink& sink) const;
+    QString toText(Order order) const;
+    void unlinkThreaded(ThreadedNode* n);   // removeLeaf：前驱后继互接，父结点空出的一侧补线索
 
     // 递归建树：当前层 curr，目标层 max（根为 1）
     ThreadedNode* buildFullRec(int curr, int max, ThreadedNode* parent, int& nextVal);
-
-    // 遍历工具（普通）
-    void preorderRec (ThreadedNode* p, QString& out)  const;
-    void inorderRec  (ThreadedNode* p, QString& out)  const;
-    void postorderRec(ThreadedNode* p, QString& out)  const;
-
-    int  leafCountRec(ThreadedNode* p) const;
-
-    // 线索化工具（所有版本都按“访问当前结点时”去补线索）
-    void clearThreadsRec(ThreadedNode* p);                 // 线索化前清线索
-    void preorderThreadRec (ThreadedNode* p, ThreadedNode*& pre);
-    void inorderThreadRec  (ThreadedNode* p, ThreadedNode*& pre);
-    void postorderThreadRec(ThreadedNode* p, ThreadedNode*& pre);
 };
 
 #endif // BINARYTREE_H
@@ -46,7 +46,7 @@ void BuildTree::on_showfuncButton_clicked()
         connect(funcShowWindow, &FuncShow::backToBuildTree,
                 this,           &BuildTree::handleBack); // 收到返回
     }
-    funcShowWindow->setRoot(tree.root());   // 关键：两页共用同一批节点指针
+    funcShowWindow->setTree(tree);          // 关键：两页共用同一棵树（同一批结点、同一份线索状态）
     funcShowWindow->show();   // 打开功能展示
     this->hide();             // 隐藏自己
 }
@@ -0,0 +1,29 @@
+#include "forkjoin.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+int ForkJoin::defaultThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ForkJoin::forEach(int count, int threads, const std::function<void(int)>& task)
+{
+    if (count <= 0) return;
+    threads = std::max(1, std::min(threads, count));
+
+    std::atomic<int> next{0};
+    auto worker = [&]{
+        for (int i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed))
+            task(i);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(size_t(threads - 1));
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+}
@@ -0,0 +1,18 @@
+#ifndef FORKJOIN_H
+#define FORKJOIN_H
+
+#include <functional>
+
+/**
+ * 极简 fork-join：把 0..count-1 号任务分给若干工作线程（调用线程也算一个），
+ * 各线程从共享计数器上逐个领任务，谁先做完谁多领，子树大小不均时也能自动均衡；
+ * forEach 返回时全部任务已完成（join）。任务之间不得写同一块内存。
+ */
+namespace ForkJoin {
+
+int  defaultThreads();                                            // 硬件线程数，至少 1
+void forEach(int count, int threads, const std::function<void(int)>& task);
+
+} // namespace ForkJoin
+
+#endif // FORKJOIN_H
@@ -2,6 +2,7 @@
 #include "ui_funcshow.h"
 #include "tree_scene.h"
 #include "threadednode.h"
+#include "binarytree.h"
 
 #include <QDebug>
 #include <QGraphicsView>
@@ -33,8 +34,8 @@ FuncShow::~FuncShow()
 void FuncShow::abortAndReset(bool keepOverlays)
 {
     if (timer_) timer_->stop();
-    animOrder_.clear();
-    animIdx_ = 0;
+    animIt_   = TraversalIterator();
+    animPrev_ = nullptr;
 
     if (scene_) {
         if (keepOverlays) scene_->clearHighlightsOnly();  // 保留箭头，只把节点刷回白色
@@ -43,11 +44,11 @@ void FuncShow::abortAndReset(bool keepOverlays)
     if (ui->outputBox) ui->outputBox->clear();
 }
 
-/* 外部注入根节点*/
-void FuncShow::setRoot(ThreadedNode* root)
+/* 外部注入要展示的树 */
+void FuncShow::setTree(BinaryTree& tree)
 {
-    root_ = root;
-    threadOrder_ = ThreadOrder::None;        // 切页或重建后，视为未线索化
+    tree_ = &tree;
+    root_ = tree.root();
     scene_->renderTree(root_);
     if (ui->outputBox) ui->outputBox->clear();
 }
@@ -65,146 +66,7 @@ void FuncShow::on_exitButton_clicked()
     qApp->quit();
 }
 
-void FuncShow::collectPreorder(ThreadedNode* p, QVector<ThreadedNode*>& out)
-{
-    if (!p) return;
-    out.push_back(p);
-    if (p->ltag == ThreadedNode::Child) collectPreorder(p->left, out);
-    if (p->rtag == ThreadedNode::Child) collectPreorder(p->right, out);
-}
-void FuncShow::collectInorder(ThreadedNode* p, QVector<ThreadedNode*>& out)
-{
-    if (!p) return;
-    if (p->ltag == ThreadedNode::Child) collectInorder(p->left, out);
-    out.push_back(p);
-    if (p->rtag == ThreadedNode::Child) collectInorder(p->right, out);
-}
-void FuncShow::collectPostorder(ThreadedNode* p, QVector<ThreadedNode*>& out)
-{
-    if (!p) return;
-    if (p->ltag == ThreadedNode::Child) collectPostorder(p->left, out);
-    if (p->rtag == ThreadedNode::Child) collectPostorder(p->right, out);
-    out.push_back(p);
-}
-
-
-// 统一入口：清线索 → 递归线索化
-void FuncShow::makePreorderThread_()
-{
-    if (!root_) return;
-    ThreadedNode::ClearAllThreads(root_);
-    ThreadedNode* pre = nullptr;
-    preorderThreadRec_(root_, pre);
-    threadOrder_ = ThreadOrder::Pre;
-}
-void FuncShow::makeInorderThread_()
-{
-    if (!root_) return;
-    ThreadedNode::ClearAllThreads(root_);
-    ThreadedNode* pre = nullptr;
-    inorderThreadRec_(root_, pre);
-    threadOrder_ = ThreadOrder::In;
-}
-void FuncShow::makePostorderThread_()
-{
-    if (!root_) return;
-    ThreadedNode::ClearAllThreads(root_);
-    ThreadedNode* pre = nullptr;
-    postorderThreadRec_(root_, pre);
-    threadOrder_ = ThreadOrder::Post;
-}
-
-// —— 三种递归：在“访问当前结点 p”时补前驱/后继 ——
-// 通用规则：
-//   if (!p->left)  p->setLeftThread(pre);
-//   if (pre && !pre->right) pre->setRightThread(p);
-//   pre = p;
-
-void FuncShow::preorderThreadRec_(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    // 访问 p（先序）
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-
-    if (p->ltag == ThreadedNode::Child) preorderThreadRec_(p->left,  pre);
-    if (p->rtag == ThreadedNode::Child) preorderThreadRec_(p->right, pre);
-}
-
-void FuncShow::inorderThreadRec_(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    if (p->ltag == ThreadedNode::Child) inorderThreadRec_(p->left, pre);
-
-    // 访问 p（中序）
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-
-    if (p->rtag == ThreadedNode::Child) inorderThreadRec_(p->right, pre);
-}
-
-void FuncShow::postorderThreadRec_(ThreadedNode* p, ThreadedNode*& pre)
-{
-    if (!p) return;
-
-    if (p->ltag == ThreadedNode::Child) postorderThreadRec_(p->left, pre);
-    if (p->rtag == ThreadedNode::Child) postorderThreadRec_(p->right, pre);
-
-    // 访问 p（后序）
-    if (!p->left)  p->setLeftThread(pre);
-    if (pre && !pre->right) pre->setRightThread(p);
-    pre = p;
-}
-
-// 线索遍历收集（非递归）
-void FuncShow::collectInorderThreaded(ThreadedNode* root, QVector<ThreadedNode*>& out)
-{
-    if (!root) return;
-    ThreadedNode* p = root->firstInorder();
-    while (p) {
-        out.push_back(p);
-        if (p->rtag == ThreadedNode::Thread) {
-            p = p->right;                        // 线索后继
-        } else {
-            if (!p->right) break;
-            ThreadedNode* q = p->right;
-            while (q && q->ltag == ThreadedNode::Child && q->left)
-                q = q->left;                     // 右子树最左
-            p = q;
-        }
-    }
-}
-
-void FuncShow::collectPreorderThreaded(ThreadedNode* root, QVector<ThreadedNode*>& out)
-{
-    if (!root) return;
-    ThreadedNode* p = root;
-    while (p) {
-        out.push_back(p);
-        if (p->ltag == ThreadedNode::Child && p->left) {
-            p = p->left;                         // 先走左孩子
-        } else {
-            p = p->right;                        // 否则右指针（右孩子或线索后继）
-        }
-    }
-}
-
 /* 可视化辅助  */
-// 旧：根据序列画“后继箭头”演示
-void FuncShow::showThreadsFromOrder(const QVector<ThreadedNode*>& order, const QColor& color)
-{
-    if (order.isEmpty()) return;
-    timer_->stop();
-
-    scene_->renderTree(root_);                   // 会清覆盖物
-    for (int i = 0; i + 1 < order.size(); ++i)
-        scene_->addArrow(order[i], order[i+1], color, /*dashed=*/true);
-}
-
 // 从整棵树按 ltag/rtag 画线索（左=前驱，右=后继）
 void FuncShow::drawThreadsFromTree_(ThreadedNode* root,
                                     const QColor& leftColor,
@@ -231,7 +93,7 @@ void FuncShow::drawThreadsFromTree_(ThreadedNode* root,
 }
 
 
-void FuncShow::playTraversal(const QVector<ThreadedNode*>& order,
+void FuncShow::playTraversal(TraversalOrder order,
                              int intervalMs,
                              bool preserveOverlays)
 {
@@ -244,29 +106,31 @@ void FuncShow::playTraversal(const QVector<ThreadedNode*>& order,
         scene_->renderTree(root_);               // 重画树（清覆盖物）
     }
 
-    animOrder_ = order;
-    animIdx_ = 0;
+    animIt_   = TraversalIterator(root_, order);
+    animPrev_ = nullptr;
     if (ui->outputBox) ui->outputBox->clear();
+    stepAnimation();                             // 第一帧立即出现
     timer_->start(intervalMs);
 }
 
 void FuncShow::stepAnimation()
 {
-    if (animIdx_ > 0 && animIdx_ <= animOrder_.size())
-        scene_->highlightNode(animOrder_[animIdx_-1], false);  // 上一个复原
+    if (animPrev_)
+        scene_->highlightNode(animPrev_, false); // 上一个复原
 
-    if (animIdx_ >= animOrder_.size()) {
+    if (animIt_.atEnd()) {
         timer_->stop();
+        animPrev_ = nullptr;
         return;
     }
 
-    auto* n = animOrder_[animIdx_];
+    ThreadedNode* n = *animIt_++;                // 现取下一个结点
     scene_->highlightNode(n, true, QColor("#FFD86E"));// 当前高亮
 
     if (ui->outputBox)
         ui->outputBox->append(QString::number(n->value));
 
-    ++animIdx_;
+    animPrev_ = n;
 }
 
 /*  普通遍历按钮 */
@@ -274,22 +138,19 @@ void FuncShow::on_preorder_search_clicked()
 {
     abortAndReset(false);                
     qDebug() << "前序遍历（普通）";
-    QVector<ThreadedNode*> v; collectPreorder(root_, v);
-    playTraversal(v, 450);
+    playTraversal(TraversalOrder::Pre, 450);
 }
 void FuncShow::on_midorder_search_clicked()
 {
     abortAndReset(false);                
     qDebug() << "中序遍历（普通）";
-    QVector<ThreadedNode*> v; collectInorder(root_, v);
-    playTraversal(v, 450);
+    playTraversal(TraversalOrder::In, 450);
 }
 void FuncShow::on_lastorder_search_clicked()
 {
     abortAndReset(false);               
     qDebug() << "后序遍历（普通）";
-    QVector<ThreadedNode*> v; collectPostorder(root_, v);
-    playTraversal(v, 450);
+    playTraversal(TraversalOrder::Post, 450);
 }
 
 /*  线索化按钮（真正改树 + 双向箭头）  */
@@ -297,7 +158,7 @@ void FuncShow::on_preclue_Button_clicked()
 {
     abortAndReset(false);                
     qDebug() << "先序线索化";
-    makePreorderThread_();
+    tree_->makePreorderThread();
     scene_->renderTree(root_);
     drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF")); // 橙=前驱，蓝=后继
 }
@@ -306,7 +167,7 @@ void FuncShow::on_midclue_Button_clicked()
 {
     abortAndReset(false);                
     qDebug() << "中序线索化";
-    makeInorderThread_();
+    tree_->makeInorderThread();
     scene_->renderTree(root_);
     drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF"));
 }
@@ -315,7 +176,7 @@ void FuncShow::on_lastclue_Button_clicked()
 {
     abortAndReset(false);                //  先停旧动画并清场景
     qDebug() << "后序线索化";
-    makePostorderThread_();
+    tree_->makePostorderThread();
     scene_->renderTree(root_);
     drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF"));
 }
@@ -325,23 +186,31 @@ void FuncShow::on_preclue_search_clicked()
 {
     abortAndReset(false);                //  先停旧动画并清场景
     // 需要先处于“先序线索化”状态；若不是则自动线索化
-    if (threadOrder_ != ThreadOrder::Pre) makePreorderThread_();
+    if (tree_->threading() != BinaryTree::Threading::Pre) tree_->makePreorderThread();
     scene_->renderTree(root_);
     drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF"));
 
-    QVector<ThreadedNode*> v; collectPreorderThreaded(root_, v);
-    playTraversal(v, 450, /*preserveOverlays=*/true);
+    playTraversal(TraversalOrder::PreThreaded, 450, /*preserveOverlays=*/true);
 }
 
 void FuncShow::on_midclue_search_clicked()
 {
     abortAndReset(false);                //  先停旧动画并清场景
-    if (threadOrder_ != ThreadOrder::In) makeInorderThread_();
+    if (tree_->threading() != BinaryTree::Threading::In) tree_->makeInorderThread();
+    scene_->renderTree(root_);
+    drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF"));
+
+    playTraversal(TraversalOrder::InThreaded, 450, /*preserveOverlays=*/true);
+}
+
+void FuncShow::on_lastclue_search_clicked()
+{
+    abortAndReset(false);                //  先停旧动画并清场景
+    if (tree_->threading() != BinaryTree::Threading::Post) tree_->makePostorderThread();
     scene_->renderTree(root_);
     drawThreadsFromTree_(root_, QColor("#F39C12"), QColor("#1F80FF"));
 
-    QVector<ThreadedNode*> v; collectInorderThreaded(root_, v);
-    playTraversal(v, 450, /*preserveOverlays=*/true);
+    playTraversal(TraversalOrder::PostThreaded, 450, /*preserveOverlays=*/true);
 }
 
 /* 统计节点数  */
@@ -0,0 +1,97 @@
+#include "implicittree.h"
+#include <QtAlgorithms>
+
+// 层高超出 [0, kMaxHeight] 时是空树；BinaryTree 在此之前就拒绝这样的层高
+ImplicitFullTree::ImplicitFullTree(int height)
+    : m_height(height >= 0 && height <= kMaxHeight ? height : 0)
+    , m_size((quint64(1) << m_height) - 1)
+{
+}
+
+// 下标 i 对应 i+1 的二进制：最高位是根，其后每一位是一次向左（0）/向右（1）
+int ImplicitFullTree::depth(quint64 i)
+{
+    return 63 - int(qCountLeadingZeroBits(i + 1));
+}
+
+// 从根沿路径往下：每走一步先序名次 +1，向右再跳过整棵左子树（2^(h-1-level) - 1 个结点）。
+// 把路径位 p 的各个 1 位合起来，跳过的总数就是 (p << (h-d)) - popcount(p)
+int ImplicitFullTree::value(quint64 i) const
+{
+    const int d = depth(i);
+    const quint64 path = (i + 1) - (quint64(1) << d);
+    return int(quint64(d) + (path << (m_height - d)) - quint64(qPopulationCount(path)) + 1);
+}
+
+// 从 v=i+1 的形式向下走 levels 层：一路向左是 v << levels，一路向右是 ((v+1) << levels) - 1
+quint64 ImplicitFullTree::leftmostLeaf(quint64 i) const
+{
+    return ((i + 1) << (m_height - 1 - depth(i))) - 1;
+}
+
+quint64 ImplicitFullTree::rightmostLeaf(quint64 i) const
+{
+    return ((i + 2) << (m_height - 1 - depth(i))) - 2;
+}
+
+// 先序：有孩子就去左孩子；否则向上爬出所有“右孩子”身份（v 末尾的 1），再到右兄弟
+quint64 ImplicitFullTree::preorderNext(quint64 i) const
+{
+    if (!isLeaf(i)) return 2 * i + 1;
+    const quint64 v = (i + 1) >> qCountTrailingZeroBits(~(i + 1));
+    return v == 0 ? kNone : v;                        // 全是 1 说明一路爬到了根；否则 v-1 是左孩子，右兄弟下标为 v
+}
+
+quint64 ImplicitFullTree::preorderPrev(quint64 i) const
+{
+    if (i == 0) return kNone;
+    if (i & 1) return (i - 1) / 2;                    // 左孩子的前驱是父结点
+    return rightmostLeaf(i - 1);                      // 右孩子：左兄弟子树的先序最后一个
+}
+
+quint64 ImplicitFullTree::inorderRank(quint64 i) const
+{
+    const int d = depth(i);
+    const quint64 pos = i - ((quint64(1) << d) - 1);
+    return (2 * pos + 1) << (m_height - 1 - d);
+}
+
+// 名次 k 末尾 0 的个数 t 就是离叶子层的距离
+quint64 ImplicitFullTree::nodeAtInorder(quint64 k) const
+{
+    if (k == 0 || k > m_size) return kNone;
+    const int t = int(qCountTrailingZeroBits(k));
+    const int d = m_height - 1 - t;
+    return ((quint64(1) << d) - 1) + (k >> (t + 1));
+}
+
+quint64 ImplicitFullTree::inorderNext(quint64 i) const
+{
+    return nodeAtInorder(inorderRank(i) + 1);
+}
+
+quint64 ImplicitFullTree::inorderPrev(quint64 i) const
+{
+    return nodeAtInorder(inorderRank(i) - 1);
+}
+
+quint64 ImplicitFullTree::postorderFirst() const
+{
+    if (!m_size) return kNone;
+    return (quint64(1) << (m_height - 1)) - 1;       // 最左叶子
+}
+
+// 后序：右孩子之后是父结点；左孩子之后是右兄弟子树的最左叶子
+quint64 ImplicitFullTree::postorderNext(quint64 i) const
+{
+    if (i == 0) return kNone;
+    if ((i & 1) == 0) return (i - 1) / 2;
+    return leftmostLeaf(i + 1);
+}
+
+quint64 ImplicitFullTree::postorderPrev(quint64 i) const
+{
+    if (!isLeaf(i)) return 2 * i + 2;                 // 内部结点的前驱是右孩子
+    const quint64 v = (i + 1) >> qCountTrailingZeroBits(i + 1);   // 爬出所有“左孩子”身份（v 末尾的 0）
+    return v == 1 ? kNone : v - 2;                    // 右孩子 v-1 的前驱是左兄弟 v-2
+}
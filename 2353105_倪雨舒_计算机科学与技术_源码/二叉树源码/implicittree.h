@@ -0,0 +1,58 @@
+#ifndef IMPLICITTREE_H
+#define IMPLICITTREE_H
+
+#include <QtGlobal>
+
+/**
+ * 满二叉树的隐式（堆式）表示：不存任何结点，第 i 个结点（按层序，从 0 开始）
+ * 的孩子是 2i+1、2i+2，父结点是 (i-1)/2。
+ * - 构造 O(1)；结点值按需计算（O(1) 位运算），与 BinaryTree::buildFullRec 的先序编号一致；
+ * - 先/中/后序的首结点、前驱、后继全部由下标的位运算得到，每步 O(1)，不需要栈；
+ * - 满二叉树的线索就是各序的前驱/后继，同样按需推出，不必存储。
+ * 下标用 quint64，层高上限 kMaxHeight（结点值仍为 int）；超出范围的层高得到空树。
+ */
+class ImplicitFullTree
+{
+public:
+    static constexpr int     kMaxHeight = 31;
+    static constexpr quint64 kNone      = ~quint64(0);
+
+    explicit ImplicitFullTree(int height = 0);
+
+    int     height() const { return m_height; }
+    quint64 size()   const { return m_size; }
+    quint64 leafCount() const { return m_height > 0 ? quint64(1) << (m_height - 1) : 0; }
+    bool    isEmpty() const { return m_size == 0; }
+
+    // 结构
+    bool    isLeaf(quint64 i) const { return 2 * i + 1 >= m_size; }
+    quint64 left  (quint64 i) const { return isLeaf(i) ? kNone : 2 * i + 1; }
+    quint64 right (quint64 i) const { return isLeaf(i) ? kNone : 2 * i + 2; }
+    quint64 parent(quint64 i) const { return i == 0 ? kNone : (i - 1) / 2; }
+    static int depth(quint64 i);
+    int     value(quint64 i) const;               // 先序编号（从 1 开始）
+
+    // 先序
+    quint64 preorderFirst() const { return m_size ? 0 : kNone; }
+    quint64 preorderNext (quint64 i) const;
+    quint64 preorderPrev (quint64 i) const;
+    // 中序：借助“中序名次 <-> 下标”的换算
+    quint64 inorderFirst() const { return m_size ? nodeAtInorder(1) : kNone; }
+    quint64 inorderNext (quint64 i) const;
+    quint64 inorderPrev (quint64 i) const;
+    quint64 inorderRank (quint64 i) const;        // 1..size
+    quint64 nodeAtInorder(quint64 k) const;
+    // 后序
+    quint64 postorderFirst() const;
+    quint64 postorderNext (quint64 i) const;
+    quint64 postorderPrev (quint64 i) const;
+
+private:
+    quint64 leftmostLeaf (quint64 i) const;       // 以 i 为根的子树里最左 / 最右的叶子
+    quint64 rightmostLeaf(quint64 i) const;
+
+    int     m_height = 0;
+    quint64 m_size   = 0;
+};
+
+#endif // IMPLICITTREE_H
@@ -1,11 +1,300 @@
 #include "mainwindow.h"
+#include "binarytree.h"
+#include "treewalk.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QLocale>
+#include <QTextStream>
 #include <QTranslator>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// 命令行（无界面）：BinaryTree --bench-build [最小层高] [最大层高]（默认 16~24）
+//   对比逐个 new/delete 与 NodeArena 两种方式建满二叉树、再整棵释放的耗时，
+//   以及 NodeArena 上串行与并行（ParallelTree）建树、数叶子、中序线索化的耗时；
+//   每个层高再补一行隐式满二叉树（Backend::Implicit）与指针树的建树耗时、存储占用、中序遍历耗时。
+// 命令行（无界面）：BinaryTree --bench-walk [最小层高] [最大层高]（默认 18~22）
+//   对比递归、沿 parent 回溯、Morris、线索四种先序/中序遍历的耗时与峰值内存
+//   （每次遍历前重置 VmHWM，量遍历期间常驻内存的最高点比起点高出多少，仅 Linux；递归另报实际栈深），
+//   最后在一条百万层的左右交替链上比较（递归会爆栈，只跑后两种不依赖线索的）。
+
+// 对照组：与 buildFullRec 相同的先序建树，但每个结点单独 new
+static ThreadedNode* heapBuild(int curr, int max, ThreadedNode* parent, int& nextVal)
+{
+    if (curr > max) return nullptr;
+    auto* node = new ThreadedNode(nextVal++, parent);
+    node->setLeftChild (heapBuild(curr + 1, max, node, nextVal));
+    node->setRightChild(heapBuild(curr + 1, max, node, nextVal));
+    return node;
+}
+
+static void heapDestroy(ThreadedNode* p)
+{
+    if (!p) return;
+    heapDestroy(p->left);
+    heapDestroy(p->right);
+    delete p;
+}
+
+// 遍历基准用的输出端：只累加，防止遍历被优化掉
+class SumSink : public TraversalSink
+{
+public:
+    void value(int v) override { m_sum += v; }
+    qint64 sum() const { return m_sum; }
+private:
+    qint64 m_sum = 0;
+};
+
+static int runBuildBench(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    int lo = 16, hi = 24;
+    int k = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-build") == 0) continue;
+        (k++ == 0 ? lo : hi) = std::atoi(argv[i]);
+    }
+
+    QTextStream out(stdout);
+    for (int h = lo; h <= hi; ++h) {
+        QElapsedTimer t;
+
+        t.start();
+        int next = 1;
+        ThreadedNode* r = heapBuild(1, h, nullptr, next);
+        const double heapBuildMs = double(t.nsecsElapsed()) / 1e6;
+        t.restart();
+        heapDestroy(r);
+        const double heapFreeMs = double(t.nsecsElapsed()) / 1e6;
+
+        BinaryTree tree;
+        tree.setThreads(1);
+        t.restart();
+        tree.buildFullByHeight(h);
+        const double arenaBuildMs = double(t.nsecsElapsed()) / 1e6;
+        const qint64 pointerBytes = tree.storageBytes();
+        SumSink pointerSum;
+        t.restart();
+        tree.write(BinaryTree::Order::In, pointerSum);
+        const double pointerWalkMs = double(t.nsecsElapsed()) / 1e6;
+        t.restart();
+        const int serialLeaves = tree.leafCount();
+        tree.makeInorderThread();
+        const double serialPassMs = double(t.nsecsElapsed()) / 1e6;
+        t.restart();
+        tree.clear();
+        const double arenaFreeMs = double(t.nsecsElapsed()) / 1e6;
+
+        BinaryTree par;                  // 默认按硬件线程数并行
+        t.restart();
+        par.buildFullByHeight(h);
+        const double parBuildMs = double(t.nsecsElapsed()) / 1e6;
+        t.restart();
+        const int parLeaves = par.leafCount();
+        par.makeInorderThread();
+        const double parPassMs = double(t.nsecsElapsed()) / 1e6;
+
+        out << "height " << h << "  nodes " << (next - 1)
+            << "  new/delete " << QString::number(heapBuildMs, 'f', 1) << " + "
+            << QString::number(heapFreeMs, 'f', 1) << " ms"
+            << "  arena " << QString::number(arenaBuildMs, 'f', 1) << " + "
+            << QString::number(arenaFreeMs, 'f', 1) << " ms"
+            << "  leaves+thread " << QString::number(serialPassMs, 'f', 1) << " ms"
+            << "  parallel x" << par.threadCount() << " build " << QString::number(parBuildMs, 'f', 1)
+            << " ms, leaves+thread " << QString::number(parPassMs, 'f', 1) << " ms"
+            << (serialLeaves == parLeaves ? "" : "  MISMATCH") << Qt::endl;
+
+        BinaryTree implicit;
+        t.restart();
+        implicit.buildFullByHeight(h, BinaryTree::Backend::Implicit);
+        const double implicitBuildMs = double(t.nsecsElapsed()) / 1e6;
+        SumSink implicitSum;
+        t.restart();
+        implicit.write(BinaryTree::Order::In, implicitSum);
+        const double implicitWalkMs = double(t.nsecsElapsed()) / 1e6;
+
+        out << "          implicit build " << QString::number(implicitBuildMs, 'f', 3) << " ms"
+            << "  storage " << implicit.storageBytes() << " B (pointer " << pointerBytes << " B)"
+            << "  inorder walk " << QString::number(implicitWalkMs, 'f', 1) << " ms (pointer "
+            << QString::number(pointerWalkMs, 'f', 1) << " ms)"
+            << (implicitSum.sum() == pointerSum.sum() && implicit.leafCount() == serialLeaves ? "" : "  MISMATCH")
+            << Qt::endl;
+    }
+    return 0;
+}
+
+// 对照组：递归遍历；顺带记下最深一层局部变量的地址，与第一层相减即实际占用的栈
+static const char* g_stackTop = nullptr;
+static const char* g_stackLow = nullptr;
+
+static void recWalk(ThreadedNode* p, bool pre, TraversalSink& sink)
+{
+    const char here = 0;
+    if (&here < g_stackLow) g_stackLow = &here;
+    if (pre) sink.value(p->value);
+    if (p->ltag == ThreadedNode::Child && p->left)  recWalk(p->left, pre, sink);
+    if (!pre) sink.value(p->value);
+    if (p->rtag == ThreadedNode::Child && p->right) recWalk(p->right, pre, sink);
+}
+
+// /proc/self/status 里某一项的值（KiB）；读不到时返回 -1
+static qint64 procStatusKiB(const char* field)
+{
+#ifdef Q_OS_LINUX
+    std::FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    const size_t n = std::strlen(field);
+    char line[256];
+    long v = -1;
+    while (std::fgets(line, sizeof line, f))
+        if (std::strncmp(line, field, n) == 0 && std::sscanf(line + n, "%ld", &v) == 1) break;
+    std::fclose(f);
+    return v;
+#else
+    Q_UNUSED(field);
+    return -1;
+#endif
+}
+
+// 一段代码的峰值内存：构造时把峰值常驻量 VmHWM 重置为当前常驻量（向 /proc/self/clear_refs 写 5），
+// peak() 返回此后 VmHWM 比起点高出多少（KiB），即这段代码最多额外占了多少内存；仅 Linux，其他平台为 -1
+class PeakMemory
+{
+public:
+    PeakMemory()
+    {
+#ifdef Q_OS_LINUX
+        if (std::FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+            const bool ok = std::fputs("5", f) >= 0;
+            if (std::fclose(f) == 0 && ok) m_base = procStatusKiB("VmRSS:");
+        }
+#endif
+    }
+    qint64 peakKiB() const
+    {
+        const qint64 hwm = procStatusKiB("VmHWM:");
+        return m_base < 0 || hwm < 0 ? -1 : hwm - m_base;
+    }
+    QString report() const
+    {
+        const qint64 kib = peakKiB();
+        return kib < 0 ? QString("peak n/a") : "peak +" + QString::number(kib) + " KiB";
+    }
+private:
+    qint64 m_base = -1;
+};
+
+static int runWalkBench(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    int lo = 18, hi = 22;
+    int k = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-walk") == 0) continue;
+        (k++ == 0 ? lo : hi) = std::atoi(argv[i]);
+    }
+
+    QTextStream out(stdout);
+    auto ms = [](const QElapsedTimer& t){ return QString::number(double(t.nsecsElapsed()) / 1e6, 'f', 1); };
+
+    for (int h = lo; h <= hi; ++h) {
+        BinaryTree tree;
+        tree.buildFullByHeight(h);
+        for (bool pre : { true, false }) {
+            const BinaryTree::Order order = pre ? BinaryTree::Order::Pre : BinaryTree::Order::In;
+            QElapsedTimer t;
+
+            SumSink rec;
+            ThreadedNode* root = tree.root();
+            const char top = 0;
+            g_stackTop = g_stackLow = &top;
+            PeakMemory recMem;
+            t.start();
+            recWalk(root, pre, rec);
+            const QString recMs = ms(t);
+            const QString recPeak = recMem.report();
+            const qint64 recStack = qint64(g_stackTop - g_stackLow);
+
+            SumSink walk;
+            tree.setStrategy(BinaryTree::Strategy::ParentWalk);
+            PeakMemory walkMem;
+            t.restart();
+            tree.write(order, walk);
+            const QString walkMs = ms(t);
+            const QString walkPeak = walkMem.report();
+
+            SumSink morris;
+            tree.setStrategy(BinaryTree::Strategy::Morris);
+            PeakMemory morrisMem;
+            t.restart();
+            tree.write(order, morris);
+            const QString morrisMs = ms(t);
+            const QString morrisPeak = morrisMem.report();
+
+            if (pre) tree.makePreorderThread(); else tree.makeInorderThread();
+            SumSink threaded;
+            PeakMemory threadedMem;
+            t.restart();
+            tree.write(pre ? BinaryTree::Order::PreThreaded : BinaryTree::Order::InThreaded, threaded);
+            const QString threadedMs = ms(t);
+            const QString threadedPeak = threadedMem.report();
+
+            const bool same = rec.sum() == walk.sum() && rec.sum() == morris.sum() && rec.sum() == threaded.sum();
+            out << "height " << h << (pre ? "  preorder " : "  inorder  ")
+                << " recursive " << recMs << " ms (stack " << recStack << " B, " << recPeak << ")"
+                << "  parent-walk " << walkMs << " ms (" << walkPeak << ")"
+                << "  morris " << morrisMs << " ms (" << morrisPeak << ")"
+                << "  threaded " << threadedMs << " ms (" << threadedPeak << ")"
+                << (same ? "" : "  MISMATCH") << Qt::endl;
+        }
+    }
+
+    // 百万层的左右交替链：递归需要 ~百万层栈帧，这里只跑不依赖栈的两种
+    const int depth = 1000000;
+    std::vector<ThreadedNode> chain;
+    chain.reserve(depth);
+    for (int i = 0; i < depth; ++i) {
+        chain.emplace_back(i + 1, nullptr);
+        if (i == 0) continue;
+        if (i & 1) chain[size_t(i - 1)].setLeftChild(&chain[size_t(i)]);
+        else       chain[size_t(i - 1)].setRightChild(&chain[size_t(i)]);
+    }
+    for (bool pre : { true, false }) {
+        QElapsedTimer t;
+        SumSink walk, morris;
+        auto putWalk   = [&](ThreadedNode* p){ walk.value(p->value); };
+        auto putMorris = [&](ThreadedNode* p){ morris.value(p->value); };
+        PeakMemory walkMem;
+        t.start();
+        if (pre) TreeWalk::preorder(&chain[0], putWalk); else TreeWalk::inorder(&chain[0], putWalk);
+        const QString walkMs = ms(t);
+        const QString walkPeak = walkMem.report();
+        PeakMemory morrisMem;
+        t.restart();
+        if (pre) TreeWalk::morrisPreorder(&chain[0], putMorris); else TreeWalk::morrisInorder(&chain[0], putMorris);
+        const QString morrisMs = ms(t);
+        const QString morrisPeak = morrisMem.report();
+        out << "chain " << depth << (pre ? "  preorder " : "  inorder  ")
+            << " parent-walk " << walkMs << " ms (" << walkPeak << ")  morris " << morrisMs << " ms (" << morrisPeak << ")"
+            << (walk.sum() == morris.sum() ? "" : "  MISMATCH") << Qt::endl;
+    }
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-build") == 0)
+            return runBuildBench(argc, argv);
+        if (std::strcmp(argv[i], "--bench-walk") == 0)
+            return runWalkBench(argc, argv);
+    }
+
     QApplication a(argc, argv);
     //  直接内联写样式
     a.setStyleSheet(R"(
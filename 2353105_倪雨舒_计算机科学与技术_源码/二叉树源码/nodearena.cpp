@@ -0,0 +1,71 @@
+#include "nodearena.h"
+#include <new>
+#include <type_traits>
+
+static_assert(std::is_trivially_destructible<ThreadedNode>::value,
+              "NodeArena 整块释放时不调用析构函数");
+
+NodeArena::~NodeArena()
+{
+    releaseAll();
+}
+
+ThreadedNode* NodeArena::create(int value, ThreadedNode* parent)
+{
+    void*   slot = nullptr;
+    quint32 id   = 0;
+    if (m_free) {
+        slot   = m_free;
+        id     = m_free->id;                         // 复用槽位也沿用原来的 id
+        m_free = m_free->left;
+    } else {
+        if (m_used == kChunkNodes) {
+            m_chunks.push_back(static_cast<ThreadedNode*>(
+                ::operator new(sizeof(ThreadedNode) * kChunkNodes)));
+            m_used = 0;
+        }
+        id   = quint32((m_chunks.size() - 1) * kChunkNodes + m_used);
+        slot = m_chunks.back() + m_used++;
+    }
+    ++m_live;
+    auto* n = new (slot) ThreadedNode(value, parent);
+    n->id = id;
+    return n;
+}
+
+void NodeArena::reserveSlots(quint32 count)
+{
+    releaseAll();
+    if (count == 0) return;
+    const quint32 chunks = (count + kChunkNodes - 1) >> kChunkShift;
+    m_chunks.reserve(chunks);
+    for (quint32 c = 0; c < chunks; ++c)
+        m_chunks.push_back(static_cast<ThreadedNode*>(
+            ::operator new(sizeof(ThreadedNode) * kChunkNodes)));
+    m_used = int(count - (chunks - 1) * quint32(kChunkNodes));
+    m_live = count;
+}
+
+ThreadedNode* NodeArena::emplace(quint32 id, int value, ThreadedNode* parent)
+{
+    auto* n = new (slot(id)) ThreadedNode(value, parent);
+    n->id = id;
+    return n;
+}
+
+void NodeArena::destroy(ThreadedNode* n)
+{
+    if (!n) return;
+    n->left = m_free;
+    m_free  = n;
+    --m_live;
+}
+
+void NodeArena::releaseAll()
+{
+    for (ThreadedNode* c : m_chunks) ::operator delete(c);
+    m_chunks.clear();
+    m_used = kChunkNodes;
+    m_free = nullptr;
+    m_live = 0;
+}
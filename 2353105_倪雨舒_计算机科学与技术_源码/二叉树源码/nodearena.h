@@ -0,0 +1,50 @@
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <QtGlobal>
+#include <vector>
+#include "threadednode.h"
+
+/**
+ * ThreadedNode 的分块内存池：
+ * - 按块（每块 kChunkNodes 个结点）向系统要内存，块内顺序分配，
+ *   建树时结点按创建顺序（先序）连续摆放，遍历时访存局部性好；
+ * - 每个结点的 id 就是它的槽位号（块号 × kChunkNodes + 块内序号），连续且稠密，
+ *   可直接当旁路表下标；
+ * - removeLeaf 释放的结点挂到空闲链上，下次分配优先复用（连同 id）；
+ * - releaseAll() 直接归还所有块，整棵树的释放是 O(块数)，不再逐个 delete；
+ * - 并行建树：reserveSlots(n) 先清空，再一次占下 0..n-1 号槽位，各线程再用 emplace(id, ...)
+ *   在互不重叠的 id 上构造结点（emplace 本身不改池的状态，可并发调用）。
+ * ThreadedNode 必须是平凡析构的（没有需要调用的析构逻辑）。
+ */
+class NodeArena
+{
+public:
+    static constexpr int kChunkShift = 14;
+    static constexpr int kChunkNodes = 1 << kChunkShift;   // 每块 16384 个结点
+    static constexpr quint32 kMaxNodes = quint32(1) << 30; // ThreadedNode::id 只有 30 位，槽位号不能超过它
+
+    NodeArena() = default;
+    ~NodeArena();
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ThreadedNode* create(int value, ThreadedNode* parent = nullptr);
+    void          destroy(ThreadedNode* n);          // 放回空闲链
+    void          releaseAll();                      // 归还全部块
+
+    void          reserveSlots(quint32 count);       // 清空后占下 0..count-1 号槽位
+    ThreadedNode* slot(quint32 id) const { return m_chunks[id >> kChunkShift] + (id & (kChunkNodes - 1)); }
+    ThreadedNode* emplace(quint32 id, int value, ThreadedNode* parent);
+
+    qint64  liveCount() const { return m_live; }
+    qint64  reservedBytes() const { return qint64(m_chunks.size()) * kChunkNodes * qint64(sizeof(ThreadedNode)); }
+
+private:
+    std::vector<ThreadedNode*> m_chunks;
+    int           m_used = kChunkNodes;              // 最后一块已用的槽位数（初始视为已满）
+    ThreadedNode* m_free = nullptr;                  // 空闲链，借用结点的 left 字段串起来
+    qint64        m_live = 0;
+};
+
+#endif // NODEARENA_H
@@ -0,0 +1,55 @@
+#ifndef NODESIDETABLE_H
+#define NODESIDETABLE_H
+
+#include <QPointF>
+#include <QVector>
+#include "threadednode.h"
+
+class NodeItem;
+
+// 单个结点的界面数据（原先直接放在 ThreadedNode 里）
+struct NodeGui
+{
+    NodeItem* item = nullptr;       // 绑定到场景中的图元
+    QPointF   posHint;              // 预布局坐标
+    bool      selected = false;
+};
+
+/**
+ * 按 ThreadedNode::id 索引的界面旁路表：每个 TreeScene 各有一份，
+ * 遍历、线索化只碰紧凑的结点本身，布局和绘制才来这里取数据。
+ */
+class NodeSideTable
+{
+public:
+    void clear() { m_rows.clear(); }
+    void reserve(int n) { m_rows.reserve(n); }
+
+    NodeGui& operator[](const ThreadedNode* n)
+    {
+        if (int(n->id) >= m_rows.size()) m_rows.resize(int(n->id) + 1);
+        return m_rows[int(n->id)];
+    }
+    const NodeGui* find(const ThreadedNode* n) const
+    {
+        return (n && int(n->id) < m_rows.size()) ? &m_rows[int(n->id)] : nullptr;
+    }
+    NodeItem* itemOf(const ThreadedNode* n) const
+    {
+        const NodeGui* g = find(n);
+        return g ? g->item : nullptr;
+    }
+
+    // 逐个访问已绑定图元的行
+    template <typename Fn>
+    void forEachItem(Fn fn) const
+    {
+        for (const NodeGui& g : m_rows)
+            if (g.item) fn(g.item);
+    }
+
+private:
+    QVector<NodeGui> m_rows;
+};
+
+#endif // NODESIDETABLE_H
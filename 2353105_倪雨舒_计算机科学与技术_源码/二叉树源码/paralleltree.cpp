@@ -0,0 +1,193 @@
+#include "paralleltree.h"
+#include "forkjoin.h"
+#include "treewalk.h"
+#include <algorithm>
+#include <numeric>
+
+using ParallelTree::Order;
+
+namespace {
+
+// 切分层：任务数取线程数的 8 倍左右，便于均衡
+int cutDepth(int threads)
+{
+    int cut = 0;
+    while ((1 << cut) < 8 * threads && cut < 16) ++cut;
+    return cut;
+}
+
+quint32 fullSize(int levels) { return (quint32(1) << levels) - 1; }
+
+template <typename Fn>
+void walk(ThreadedNode* root, Order order, Fn fn)
+{
+    switch (order) {
+    case Order::Pre:  TreeWalk::preorder (root, fn); break;
+    case Order::In:   TreeWalk::inorder  (root, fn); break;
+    case Order::Post: TreeWalk::postorder(root, fn); break;
+    }
+}
+
+// 上层按访问顺序摊平：node 非空是上层结点，否则是第 sub 棵子树
+struct Item { ThreadedNode* node; int sub; };
+struct Split {
+    std::vector<Item>          items;
+    std::vector<ThreadedNode*> roots;
+};
+
+// 上层至多 cut 层，递归深度有界
+void splitRec(ThreadedNode* p, int depth, int cut, Order order, Split& s)
+{
+    if (depth == cut) {
+        s.items.push_back({ nullptr, int(s.roots.size()) });
+        s.roots.push_back(p);
+        return;
+    }
+    if (order == Order::Pre) s.items.push_back({ p, -1 });
+    if (TreeWalk::leftChild(p)) splitRec(p->left, depth + 1, cut, order, s);
+    if (order == Order::In) s.items.push_back({ p, -1 });
+    if (TreeWalk::rightChild(p)) splitRec(p->right, depth + 1, cut, order, s);
+    if (order == Order::Post) s.items.push_back({ p, -1 });
+}
+
+Split split(ThreadedNode* root, Order order, int threads)
+{
+    Split s;
+    if (root) splitRec(root, 0, cutDepth(threads), order, s);
+    return s;
+}
+
+// 在 [value, value + fullSize(levels)) 里按先序建满子树
+ThreadedNode* buildRange(NodeArena& arena, int value, int levels, ThreadedNode* parent)
+{
+    ThreadedNode* n = arena.emplace(quint32(value - 1), value, parent);
+    if (levels > 1) {
+        n->setLeftChild (buildRange(arena, value + 1, levels - 1, n));
+        n->setRightChild(buildRange(arena, value + 1 + int(fullSize(levels - 1)), levels - 1, n));
+    }
+    return n;
+}
+
+struct BuildJob { int value; int levels; ThreadedNode* parent; };
+
+// 上层串行建；到第 cut 层只把孩子指针指向将来的槽位，留给任务去构造
+ThreadedNode* buildTop(NodeArena& arena, int value, int levels, int depth, int cut,
+                       ThreadedNode* parent, std::vector<BuildJob>& jobs)
+{
+    ThreadedNode* n = arena.emplace(quint32(value - 1), value, parent);
+    if (levels == 1) return n;
+
+    const int lv = value + 1;
+    const int rv = value + 1 + int(fullSize(levels - 1));
+    if (depth + 1 == cut) {
+        jobs.push_back({ lv, levels - 1, n });
+        jobs.push_back({ rv, levels - 1, n });
+        n->left  = arena.slot(quint32(lv - 1));
+        n->right = arena.slot(quint32(rv - 1));
+    } else {
+        n->setLeftChild (buildTop(arena, lv, levels - 1, depth + 1, cut, n, jobs));
+        n->setRightChild(buildTop(arena, rv, levels - 1, depth + 1, cut, n, jobs));
+    }
+    return n;
+}
+
+} // namespace
+
+ThreadedNode* ParallelTree::buildFull(NodeArena& arena, int height, int threads)
+{
+    if (height <= 0) return nullptr;
+    arena.reserveSlots(fullSize(height));
+
+    const int cut = std::min(cutDepth(threads), height - 1);
+    if (cut == 0) return buildRange(arena, 1, height, nullptr);
+
+    std::vector<BuildJob> jobs;
+    ThreadedNode* root = buildTop(arena, 1, height, 0, cut, nullptr, jobs);
+    ForkJoin::forEach(int(jobs.size()), threads, [&](int i){
+        const BuildJob& j = jobs[size_t(i)];
+        buildRange(arena, j.value, j.levels, j.parent);
+    });
+    return root;
+}
+
+qint64 ParallelTree::leafCount(ThreadedNode* root, int threads)
+{
+    const Split s = split(root, Order::Pre, threads);
+    std::vector<qint64> counts(s.roots.size(), 0);
+    ForkJoin::forEach(int(s.roots.size()), threads, [&](int i){
+        qint64 c = 0;
+        TreeWalk::preorder(s.roots[size_t(i)], [&](ThreadedNode* p){
+            if (!TreeWalk::leftChild(p) && !TreeWalk::rightChild(p)) ++c;
+        });
+        counts[size_t(i)] = c;
+    });
+
+    qint64 total = std::accumulate(counts.begin(), counts.end(), qint64(0));
+    for (const Item& it : s.items)
+        if (it.node && !TreeWalk::leftChild(it.node) && !TreeWalk::rightChild(it.node)) ++total;
+    return total;
+}
+
+void ParallelTree::sequence(ThreadedNode* root, Order order, int threads, std::vector<int>& out)
+{
+    out.clear();
+    const Split s = split(root, order, threads);
+    const int n = int(s.roots.size());
+
+    std::vector<size_t> sizes(size_t(n), 0);
+    ForkJoin::forEach(n, threads, [&](int i){
+        size_t c = 0;
+        TreeWalk::preorder(s.roots[size_t(i)], [&](ThreadedNode*){ ++c; });
+        sizes[size_t(i)] = c;
+    });
+
+    // 按上层访问顺序排出各段起点；上层结点直接写
+    std::vector<size_t> offsets(size_t(n), 0);
+    size_t total = 0;
+    for (const Item& it : s.items)
+        total += it.node ? 1 : sizes[size_t(it.sub)];
+    out.resize(total);
+    size_t pos = 0;
+    for (const Item& it : s.items) {
+        if (it.node) { out[pos++] = it.node->value; continue; }
+        offsets[size_t(it.sub)] = pos;
+        pos += sizes[size_t(it.sub)];
+    }
+
+    ForkJoin::forEach(n, threads, [&](int i){
+        int* dst = out.data() + offsets[size_t(i)];
+        walk(s.roots[size_t(i)], order, [&](ThreadedNode* p){ *dst++ = p->value; });
+    });
+}
+
+void ParallelTree::thread(ThreadedNode* root, Order order, int threads)
+{
+    if (!root) return;
+    const Split s = split(root, order, threads);
+    const int n = int(s.roots.size());
+
+    for (const Item& it : s.items)
+        if (it.node) it.node->clearThreads();
+
+    std::vector<ThreadedNode*> first(size_t(n), nullptr), last(size_t(n), nullptr);
+    ForkJoin::forEach(n, threads, [&](int i){
+        ThreadedNode* r = s.roots[size_t(i)];
+        TreeWalk::preorder(r, [](ThreadedNode* p){ p->clearThreads(); });
+        ThreadedNode* pre = nullptr;
+        walk(r, order, [&](ThreadedNode* p){
+            if (!pre) first[size_t(i)] = p;
+            TreeWalk::threadVisit(p, pre);
+        });
+        last[size_t(i)] = pre;
+    });
+
+    // 缝合：段内第一个结点在本地线索化时拿到的是空前驱
+    ThreadedNode* pre = nullptr;
+    for (const Item& it : s.items) {
+        if (it.node) { TreeWalk::threadVisit(it.node, pre); continue; }
+        ThreadedNode* f = first[size_t(it.sub)];
+        if (f->ltag == ThreadedNode::Thread && !f->left) f->left = pre;
+        if (pre && !pre->right) pre->setRightThread(f);
+        pre = last[size_t(it.sub)];
+    }
+}
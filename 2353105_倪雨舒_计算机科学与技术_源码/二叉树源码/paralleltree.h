@@ -0,0 +1,32 @@
+#ifndef PARALLELTREE_H
+#define PARALLELTREE_H
+
+#include <QtGlobal>
+#include <vector>
+#include "threadednode.h"
+#include "nodearena.h"
+
+/**
+ * 大树的并行版本（ForkJoin）：在第 cut 层把树切开，上面几层（至多 2^cut 个结点）串行处理，
+ * 下面每棵子树是一个任务，互不相交，可以同时做：
+ * - buildFull: 满二叉树的结点值就是先序编号，子树的取值区间可直接算出；
+ *   先 reserveSlots 占好槽位（id = 值 - 1，与串行建树一致），各子树在自己的区间里构造；
+ * - leafCount: 各子树分别计数再求和；
+ * - sequence: 先并行数出各子树结点数，按上层的访问顺序排出每棵子树在结果数组里的起点，
+ *   再并行把各段填好；
+ * - thread: 各子树独立线索化（起点的 pre 为空），记下本段首尾结点，
+ *   再按上层访问顺序串行“缝合”：段首的空左线索接上前一段的末尾，前一段末尾的空右指针接段首。
+ * 遍历一律用 TreeWalk（不读 parent 以外的共享状态）。
+ */
+namespace ParallelTree {
+
+enum class Order { Pre, In, Post };
+
+ThreadedNode* buildFull(NodeArena& arena, int height, int threads);
+qint64        leafCount(ThreadedNode* root, int threads);
+void          sequence(ThreadedNode* root, Order order, int threads, std::vector<int>& out);
+void          thread(ThreadedNode* root, Order order, int threads);   // 先清旧线索
+
+} // namespace ParallelTree
+
+#endif // PARALLELTREE_H
@@ -1,7 +1,8 @@
 #include "threadednode.h"
+#include "treewalk.h"
 
 ThreadedNode::ThreadedNode(int v, ThreadedNode* p)
-    : value(v), parent(p)
+    : value(v), id(0), ltag(Child), rtag(Child), parent(p)
 {
 }
 
@@ -59,41 +60,25 @@ void ThreadedNode::clearThreads()
 }
 
 /* 静态：整棵树清线索
- * 注意：只有在该侧为“Thread”时才清指针；如果是 Child，就递归到相应子树。
+ * 沿真实孩子走一遍（TreeWalk，非递归），逐个结点把线索侧还原为空孩子。
  */
 void ThreadedNode::ClearAllThreads(ThreadedNode* root)
 {
-    if (!root) return;
-
-    // 左侧：若是线索则清空；若是孩子则递归
-    if (root->ltag == Thread) {
-        root->left = nullptr;
-        root->ltag = Child;
-    } else if (root->left) {
-        ClearAllThreads(root->left);
-    }
-
-    // 右侧：同理
-    if (root->rtag == Thread) {
-        root->right = nullptr;
-        root->rtag = Child;
-    } else if (root->right) {
-        ClearAllThreads(root->right);
-    }
+    TreeWalk::preorder(root, [](ThreadedNode* p){ p->clearThreads(); });
 }
 
 /* 静态：整棵子树刷新 parent 指针
- * 只对“孩子方向”为 Child 的分支递归；线索不参与 parent 链接。
+ * 只沿“孩子方向”为 Child 的分支；线索不参与 parent 链接。
+ * parent 本身可能是错的，所以不能用借 parent 回溯的 euler()，改用显式栈。
  */
 void ThreadedNode::ResetParent(ThreadedNode* root, ThreadedNode* parent)
 {
     if (!root) return;
     root->parent = parent;
-
-    if (root->ltag == Child && root->left)
-        ResetParent(root->left, root);
-    if (root->rtag == Child && root->right)
-        ResetParent(root->right, root);
+    TreeWalk::topDown(root, [](ThreadedNode* p){
+        if (p->hasLeftChild())  p->left->parent  = p;
+        if (p->hasRightChild()) p->right->parent = p;
+    });
 }
 
 ThreadedNode* ThreadedNode::firstInorder()
@@ -109,12 +94,14 @@ ThreadedNode* ThreadedNode::inorderSuccessor()
     // 若右侧为线索，则 right 即后继
     if (rtag == Thread) return right;
 
-    // 否则进入右子树，取其最左
-    if (!hasRightChild()) return nullptr;
-    ThreadedNode* p = right;
-    while (p->ltag == Child && p->left)
-        p = p->left;
-    return p;
+    // 有右子树：取其最左
+    if (hasRightChild()) return right->firstInorder();
+
+    // 否则向上，直到从某个结点的左子树上来
+    ThreadedNode* p = this;
+    while (p->parent && p->parent->right == p && p->parent->rtag == Child)
+        p = p->parent;
+    return p->parent;
 }
 
 ThreadedNode* ThreadedNode::inorderPredecessor()
@@ -122,10 +109,80 @@ ThreadedNode* ThreadedNode::inorderPredecessor()
     // 若左侧为线索，则 left 即前驱
     if (ltag == Thread) return left;
 
-    // 否则进入左子树，取其最右
-    if (!hasLeftChild()) return nullptr;
-    ThreadedNode* p = left;
-    while (p->rtag == Child && p->right)
-        p = p->right;
-    return p;
+    // 有左子树：取其最右
+    if (hasLeftChild()) {
+        ThreadedNode* p = left;
+        while (p->rtag == Child && p->right)
+            p = p->right;
+        return p;
+    }
+
+    // 否则向上，直到从某个结点的右子树上来
+    ThreadedNode* p = this;
+    while (p->parent && p->parent->left == p && p->parent->ltag == Child)
+        p = p->parent;
+    return p->parent;
+}
+
+// 先序后继：左孩子 > 右孩子（或右线索）> 向上找第一个“从左边上来且有右孩子”的祖先，取其右孩子
+ThreadedNode* ThreadedNode::preorderSuccessor()
+{
+    if (hasLeftChild()) return left;
+    if (rtag == Thread || hasRightChild()) return right;
+
+    ThreadedNode* p = this;
+    while (ThreadedNode* q = p->parent) {
+        if (q->left == p && q->ltag == Child && q->hasRightChild()) return q->right;
+        p = q;
+    }
+    return nullptr;
+}
+
+// 先序前驱：左线索；否则是父结点，或父结点左子树里先序最后的结点（右优先一路下到叶子）
+ThreadedNode* ThreadedNode::preorderPredecessor()
+{
+    if (ltag == Thread) return left;
+
+    ThreadedNode* q = parent;
+    if (!q || !q->hasLeftChild() || q->left == this) return q;
+    ThreadedNode* p = q->left;
+    for (;;) {
+        if      (p->hasRightChild()) p = p->right;
+        else if (p->hasLeftChild())  p = p->left;
+        else return p;
+    }
+}
+
+ThreadedNode* ThreadedNode::firstPostorder()
+{
+    ThreadedNode* p = this;
+    for (;;) {
+        if      (p->hasLeftChild())  p = p->left;
+        else if (p->hasRightChild()) p = p->right;
+        else return p;
+    }
+}
+
+// 后序后继：右线索；否则是父结点，或父结点右子树的后序第一个
+ThreadedNode* ThreadedNode::postorderSuccessor()
+{
+    if (rtag == Thread) return right;
+
+    ThreadedNode* q = parent;
+    if (!q || !q->hasRightChild() || q->right == this) return q;
+    return q->right->firstPostorder();
+}
+
+// 后序前驱：右孩子 > 左孩子（或左线索）> 向上找第一个“从右边上来且有左孩子”的祖先，取其左孩子
+ThreadedNode* ThreadedNode::postorderPredecessor()
+{
+    if (hasRightChild()) return right;
+    if (ltag == Thread || hasLeftChild()) return left;
+
+    ThreadedNode* p = this;
+    while (ThreadedNode* q = p->parent) {
+        if (q->right == p && q->rtag == Child && q->hasLeftChild()) return q->left;
+        p = q;
+    }
+    return nullptr;
 }
@@ -2,13 +2,12 @@
 #define THREADEDNODE_H
 
 #include <QtGlobal>
-#include <QPointF>
-
-class QGraphicsItem;   // 只做前向声明，避免引入图形模块的重编译
 
 /**
  * 线索二叉树的“节点”——仅封装节点本身的状态与常用操作。
  * 不负责节点的生命周期管理（释放由树统一处理）。
+ * 只保留遍历/线索化要用的字段：两个标记与结点 id 合用一个 32 位字，整个结点 32 字节；
+ * 图元、预布局坐标等界面数据放在按 id 索引的 NodeSideTable 里。
  */
 class ThreadedNode
 {
@@ -18,18 +17,14 @@ public:
 
     int value = 0;
 
+    quint32 id   : 30;              // NodeArena 槽位号，界面旁路表的下标
+    quint32 ltag : 1;               // 取值为 Tag
+    quint32 rtag : 1;
+
     ThreadedNode* left   = nullptr;
     ThreadedNode* right  = nullptr;
     ThreadedNode* parent = nullptr;
 
-    Tag ltag = Child;
-    Tag rtag = Child;
-
-    // 
-    QGraphicsItem* gfx = nullptr;   // 绑定到场景中的图元
-    QPointF         posHint;        // 预布局坐标（可选）
-    bool            selected = false;
-
 public:
     explicit ThreadedNode(int v = 0, ThreadedNode* p = nullptr);
 
@@ -53,18 +48,23 @@ public:
     void clearThreads();                    // 如果当前为线索则清空并还原为 Child
 
     
-    static void ClearAllThreads(ThreadedNode* root);           // 递归清整棵树线索
+    static void ClearAllThreads(ThreadedNode* root);           // 清整棵树线索（非递归）
     static void ResetParent(ThreadedNode* root,
-                            ThreadedNode* parent = nullptr);   // 递归刷新 parent
+                            ThreadedNode* parent = nullptr);   // 刷新 parent（非递归）
 
-    // 可视化辅助
-    void bindGraphics(QGraphicsItem* item) { gfx = item; }
-    void setSelected(bool on) { selected = on; }
-
-    // —— 中序导航：结合线索与孩子，做局部邻接查找 ——
+    // —— 前驱/后继导航：结合线索、孩子与 parent，做局部邻接查找 ——
+    // 树按对应顺序线索化时直接走线索；没有可用线索时沿孩子/parent 推出（未线索化的树也正确）。
+    // 均为 O(1) 额外空间；单次最坏 O(树高)，沿整个序列走一遍总计 O(n)。
     ThreadedNode* firstInorder();        // 以当前结点为根找到最左端
     ThreadedNode* inorderSuccessor();    // 中序后继（考虑线索）
     ThreadedNode* inorderPredecessor();  // 中序前驱（考虑线索）
+
+    ThreadedNode* preorderSuccessor();
+    ThreadedNode* preorderPredecessor();
+
+    ThreadedNode* firstPostorder();      // 以当前结点为根，后序第一个（左优先一路下到叶子）
+    ThreadedNode* postorderSuccessor();
+    ThreadedNode* postorderPredecessor();
 };
 
 #endif // THREADEDNODE_H
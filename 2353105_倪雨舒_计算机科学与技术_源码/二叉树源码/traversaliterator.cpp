@@ -0,0 +1,65 @@
+#include "traversaliterator.h"
+
+TraversalIterator::TraversalIterator(ThreadedNode* root, TraversalOrder order)
+    : m_root(root), m_order(order)
+{
+    if (!root) return;
+    switch (order) {
+    case TraversalOrder::PreThreaded:  m_node = root;                   break;
+    case TraversalOrder::InThreaded:   m_node = root->firstInorder();   break;
+    case TraversalOrder::PostThreaded: m_node = root->firstPostorder(); break;
+    default:
+        m_node  = root;
+        m_phase = Enter;
+        if (order != TraversalOrder::Pre) stepEuler();            // 根的 Enter 不是中/后序的访问时刻
+        break;
+    }
+}
+
+void TraversalIterator::advance()
+{
+    ThreadedNode* p = m_node;
+    if (!p) return;
+    switch (m_order) {
+    case TraversalOrder::PreThreaded:
+        // 有左孩子走左孩子；否则右指针（右孩子或线索后继）
+        m_node = p->hasLeftChild() ? p->left : p->right;
+        break;
+    case TraversalOrder::InThreaded:
+        if (p->rtag == ThreadedNode::Thread) m_node = p->right;
+        else m_node = p->right ? p->right->firstInorder() : nullptr;
+        break;
+    case TraversalOrder::PostThreaded:
+        m_node = (p == m_root) ? nullptr : p->postorderSuccessor();
+        break;
+    default:
+        stepEuler();
+        break;
+    }
+}
+
+// 从当前 (结点, 时刻) 往下推，直到下一个属于本顺序的访问时刻
+void TraversalIterator::stepEuler()
+{
+    const Phase want = m_order == TraversalOrder::Pre ? Enter
+                     : m_order == TraversalOrder::In  ? Middle : Exit;
+    for (;;) {
+        ThreadedNode* p = m_node;
+        switch (m_phase) {
+        case Enter:
+            if (p->hasLeftChild()) m_node = p->left;
+            else                   m_phase = Middle;
+            break;
+        case Middle:
+            if (p->hasRightChild()) { m_node = p->right; m_phase = Enter; }
+            else                    m_phase = Exit;
+            break;
+        case Exit:
+            if (p == m_root) { m_node = nullptr; return; }
+            m_node  = p->parent;
+            m_phase = (m_node->left == p && m_node->ltag == ThreadedNode::Child) ? Middle : Exit;
+            break;
+        }
+        if (m_phase == want) return;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef TRAVERSALITERATOR_H
+#define TRAVERSALITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "threadednode.h"
+
+enum class TraversalOrder { Pre, In, Post, PreThreaded, InThreaded, PostThreaded };
+
+/**
+ * 惰性遍历迭代器（前向迭代器，可用于 range-for 与 STL 算法）：
+ * 每次 ++ 才推进到下一个结点，状态只有几个指针，不预先收集整个序列。
+ * - Pre/In/Post：与 TreeWalk::euler 同一套“下来 / 左边回来 / 右边回来”状态机，
+ *   只沿真实孩子走，借 parent 回溯；已线索化的树也照常工作；
+ * - PreThreaded/InThreaded/PostThreaded：走对应顺序的线索（后序借 parent，见 postorderSuccessor），
+ *   要求树已按该顺序线索化。
+ * 迭代期间不要增删结点。
+ */
+class TraversalIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = ThreadedNode*;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = ThreadedNode* const*;
+    using reference         = ThreadedNode* const&;
+
+    TraversalIterator() = default;                            // 结束位置
+    TraversalIterator(ThreadedNode* root, TraversalOrder order);
+
+    reference operator*()  const { return m_node; }
+    pointer   operator->() const { return &m_node; }
+
+    TraversalIterator& operator++() { advance(); return *this; }
+    TraversalIterator  operator++(int) { TraversalIterator old = *this; advance(); return old; }
+
+    bool operator==(const TraversalIterator& o) const { return m_node == o.m_node; }
+    bool operator!=(const TraversalIterator& o) const { return m_node != o.m_node; }
+
+    bool atEnd() const { return m_node == nullptr; }
+
+private:
+    enum Phase : quint8 { Enter, Middle, Exit };              // 先/中/后序的访问时刻
+
+    void advance();
+    void stepEuler();
+
+    ThreadedNode*  m_root  = nullptr;
+    ThreadedNode*  m_node  = nullptr;
+    TraversalOrder m_order = TraversalOrder::Pre;
+    Phase          m_phase = Enter;
+};
+
+// 一次遍历的区间：for (ThreadedNode* p : Traversal(root, TraversalOrder::In)) ...
+class Traversal
+{
+public:
+    Traversal(ThreadedNode* root, TraversalOrder order) : m_root(root), m_order(order) {}
+    TraversalIterator begin() const { return TraversalIterator(m_root, m_order); }
+    TraversalIterator end()   const { return TraversalIterator(); }
+private:
+    ThreadedNode*  m_root;
+    TraversalOrder m_order;
+};
+
+#endif // TRAVERSALITERATOR_H
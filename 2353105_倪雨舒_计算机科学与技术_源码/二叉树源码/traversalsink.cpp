@@ -0,0 +1,33 @@
+#include "traversalsink.h"
+#include <cstring>
+
+// 两位一组查表，从低位往高位写进临时区再整体拷出
+int TextSink::formatInt(int v, char* out)
+{
+    static const char kPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    char tmp[12];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    quint32 u = v < 0 ? 0u - quint32(v) : quint32(v);
+    while (u >= 100) {
+        const quint32 r = u % 100;
+        u /= 100;
+        p -= 2;
+        std::memcpy(p, kPairs + 2 * r, 2);
+    }
+    if (u >= 10) {
+        p -= 2;
+        std::memcpy(p, kPairs + 2 * u, 2);
+    } else {
+        *--p = char('0' + u);
+    }
+    if (v < 0) *--p = '-';
+
+    const int len = int(end - p);
+    std::memcpy(out, p, size_t(len));
+    return len;
+}
@@ -0,0 +1,94 @@
+#ifndef TRAVERSALSINK_H
+#define TRAVERSALSINK_H
+
+#include <QtGlobal>
+#include <QString>
+#include <cstdio>
+#include <functional>
+#include <utility>
+
+/**
+ * 遍历结果的输出端：BinaryTree::write() 每访问一个结点调用一次 value()，
+ * 遍历结束调用 finish()。
+ * - TextSink：值转十进制、以空格分隔，写进固定大小的 char 缓冲，满了整块交给 write()；
+ *   不为每个结点生成临时 QString。派生出 StringSink（拼到 QString）、FileSink（写 FILE*）；
+ * - CallbackSink：直接把值交给回调，不做格式化；
+ * - CountSink：只计数。
+ */
+class TraversalSink
+{
+public:
+    virtual ~TraversalSink() = default;
+    virtual void value(int v) = 0;
+    virtual void finish() {}
+};
+
+class TextSink : public TraversalSink
+{
+public:
+    static constexpr int kBufferBytes = 16 * 1024;
+
+    void value(int v) override
+    {
+        if (m_len > kBufferBytes - 13) flush();   // 最长一项：空格 + "-2147483648"
+        if (m_count++) m_buf[m_len++] = ' ';
+        m_len += formatInt(v, m_buf + m_len);
+    }
+    void finish() override { flush(); }
+
+    qint64 count() const { return m_count; }
+
+    static int formatInt(int v, char* out);      // 写十进制，返回字节数（不加结尾 0）
+
+protected:
+    virtual void write(const char* data, int len) = 0;
+
+private:
+    void flush() { if (m_len) { write(m_buf, m_len); m_len = 0; } }
+
+    char   m_buf[kBufferBytes];
+    int    m_len   = 0;
+    qint64 m_count = 0;
+};
+
+// 追加到调用方的 QString（按块转 Latin-1 追加）
+class StringSink : public TextSink
+{
+public:
+    explicit StringSink(QString& out) : m_out(out) {}
+protected:
+    void write(const char* data, int len) override { m_out.append(QLatin1String(data, len)); }
+private:
+    QString& m_out;
+};
+
+// 直接写文件流，百万结点的结果不必整体驻留内存
+class FileSink : public TextSink
+{
+public:
+    explicit FileSink(FILE* fp) : m_fp(fp) {}
+protected:
+    void write(const char* data, int len) override { std::fwrite(data, 1, size_t(len), m_fp); }
+private:
+    FILE* m_fp;
+};
+
+class CallbackSink : public TraversalSink
+{
+public:
+    explicit CallbackSink(std::function<void(int)> fn) : m_fn(std::move(fn)) {}
+    void value(int v) override { m_fn(v); }
+private:
+    std::function<void(int)> m_fn;
+};
+
+class CountSink : public TraversalSink
+{
+public:
+    void value(int) override { ++m_count; }
+    qint64 count() const { return m_count; }
+private:
+    qint64 m_count = 0;
+};
+
+#endif // TRAVERSALSINK_H
@@ -19,7 +19,7 @@ void TreeScene::renderTree(ThreadedNode* root)
     clearOverlays();
 
     clear();                // 删除所有图元（节点、线等）
-    m_items.clear();
+    m_gui.clear();
 
     if (!root) return;
 
@@ -38,7 +38,7 @@ void TreeScene::layoutCompact(ThreadedNode* root)
     applyYByDepth(root, /*depth*/0);              // 设 y
 }
 
-// 返回该节点的 x；顺手把 p->posHint.x() 设好
+// 返回该节点的 x；顺手把旁路表里的 posHint.x() 设好
 double TreeScene::layoutAssignX(ThreadedNode* p, int depth, double& leafCursor)
 {
     if (!p) return 0.0;
@@ -61,14 +61,14 @@ double TreeScene::layoutAssignX(ThreadedNode* p, int depth, double& leafCursor)
         else                   x = xr;
     }
 
-    p->posHint.setX(x);
+    m_gui[p].posHint.setX(x);
     return x;
 }
 
 void TreeScene::applyYByDepth(ThreadedNode* p, int depth)
 {
     if (!p) return;
-    p->posHint.setY(depth * m_dy);
+    m_gui[p].posHint.setY(depth * m_dy);
     if (p->ltag == ThreadedNode::Child) applyYByDepth(p->left,  depth + 1);
     if (p->rtag == ThreadedNode::Child) applyYByDepth(p->right, depth + 1);
 }
@@ -77,18 +77,19 @@ void TreeScene::applyYByDepth(ThreadedNode* p, int depth)
 
 NodeItem* TreeScene::ensureNodeItem(ThreadedNode* p)
 {
-    if (m_items.contains(p)) return m_items[p];
+    NodeGui& g = m_gui[p];
+    if (g.item) return g.item;
 
     auto* item = new NodeItem(p);
     addItem(item);
-    item->setPos(p->posHint);
+    item->setPos(g.posHint);
     item->setZValue(1);                 // 节点在上层
 
     // 在节点内放编号，省去外部文字图元
     item->setLabel(QString::number(p->value));
 
     connect(item, &NodeItem::clicked, this, &TreeScene::nodeClicked);
-    m_items.insert(p, item);
+    g.item = item;
     return item;
 }
 
@@ -126,18 +127,19 @@ void TreeScene::clearOverlays()
     m_overlays.clear();
 
     // 还原节点高亮
-    for (auto* it : m_items) it->setHighlighted(false);
+    m_gui.forEachItem([](NodeItem* it){ it->setHighlighted(false); });
 }
 
 void TreeScene::clearHighlightsOnly()
 {
-    for (auto* it : m_items) it->setHighlighted(false);
+    m_gui.forEachItem([](NodeItem* it){ it->setHighlighted(false); });
 }
 
 void TreeScene::highlightNode(ThreadedNode* n, bool on, const QColor& fill)
 {
     if (!n) return;
     if (auto* it = itemOf(n)) it->setHighlighted(on, fill);
+    m_gui[n].selected = on;
 }
 
 /* ================== 箭头（线索/遍历辅助） ================== */
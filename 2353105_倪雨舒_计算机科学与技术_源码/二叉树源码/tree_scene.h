@@ -2,9 +2,9 @@
 #define TREE_SCENE_H
 
 #include <QGraphicsScene>
-#include <QMap>
 #include <QList>
 #include <QColor>
+#include "nodesidetable.h"
 
 class ThreadedNode;
 class NodeItem;
@@ -39,7 +39,7 @@ private:
     // —— 绘制 ——
     void drawDfs(ThreadedNode* p);
     NodeItem* ensureNodeItem(ThreadedNode* p);
-    NodeItem* itemOf(ThreadedNode* p) const { return m_items.value(p, nullptr); }
+    NodeItem* itemOf(ThreadedNode* p) const { return m_gui.itemOf(p); }
 
 private:
     // 布局参数
@@ -47,7 +47,7 @@ private:
     double m_shrink   = 0.85;   // 每深入一层水平间距乘该因子（越小越“瘦”）
     double m_dy       = 110.0;  // 垂直层距
 
-    QMap<ThreadedNode*, NodeItem*> m_items;
+    NodeSideTable m_gui;                   // 结点 id -> 图元 / 预布局坐标
     QList<QGraphicsItem*> m_overlays;      // 箭头、高亮辅助形状
 };
 
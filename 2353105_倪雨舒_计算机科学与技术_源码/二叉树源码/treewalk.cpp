@@ -0,0 +1,8 @@
+#include "treewalk.h"
+
+std::vector<ThreadedNode*>& TreeWalk::scratchStack()
+{
+    thread_local std::vector<ThreadedNode*> stack;
+    stack.clear();                               // 保留容量，下次不再分配
+    return stack;
+}
@@ -0,0 +1,131 @@
+#ifndef TREEWALK_H
+#define TREEWALK_H
+
+#include <vector>
+#include "threadednode.h"
+
+/**
+ * 非递归遍历引擎（只沿真实孩子走，线索不当孩子）：
+ * - euler(): 借 parent 指针做 Euler 回路，每个结点依次经历“下来 / 左子树回来 / 右子树回来”，
+ *   分别回调 pre / in / post；不用栈、不分配内存，任意深度都不会爆栈。
+ *   要求 parent 指针正确；回调里只允许把空指针补成线索（线索化正是如此），不能改真实孩子。
+ * - morrisPreorder()/morrisInorder(): Morris 遍历，借“无右孩子”结点的 right 临时连回祖先，
+ *   不用栈也不读 parent；走完后 right/rtag 与 parent 都恢复原样（原有线索也保留）。
+ * - topDown(): 显式栈的先序，用于 parent 本身待修复的场合（ResetParent）；
+ *   栈是线程内复用的缓冲，只在首次或更深时扩容。
+ */
+namespace TreeWalk {
+
+// 热路径上直接看标记，不走 threadednode.cpp 里的非内联版本
+inline bool leftChild (const ThreadedNode* p) { return p->ltag == ThreadedNode::Child && p->left;  }
+inline bool rightChild(const ThreadedNode* p) { return p->rtag == ThreadedNode::Child && p->right; }
+
+// 线索化时“访问 p”：空左指针接前驱，前一个结点的空右指针接 p
+inline void threadVisit(ThreadedNode* p, ThreadedNode*& pre)
+{
+    if (!p->left)  p->setLeftThread(pre);
+    if (pre && !pre->right) pre->setRightThread(p);
+    pre = p;
+}
+
+template <typename Pre, typename In, typename Post>
+void euler(ThreadedNode* root, Pre pre, In in, Post post)
+{
+    enum { Down, FromLeft, FromRight } state = Down;
+    ThreadedNode* p = root;
+    while (p) {
+        if (state == Down) {
+            pre(p);
+            if (leftChild(p)) { p = p->left; continue; }
+            state = FromLeft;
+        }
+        if (state == FromLeft) {
+            in(p);
+            if (rightChild(p)) { p = p->right; state = Down; continue; }
+        }
+        post(p);
+        if (p == root) break;
+        ThreadedNode* up = p->parent;
+        state = (up->left == p && up->ltag == ThreadedNode::Child) ? FromLeft : FromRight;
+        p = up;
+    }
+}
+
+template <typename Fn>
+void preorder(ThreadedNode* root, Fn fn)  { euler(root, fn, [](ThreadedNode*){}, [](ThreadedNode*){}); }
+template <typename Fn>
+void inorder(ThreadedNode* root, Fn fn)   { euler(root, [](ThreadedNode*){}, fn, [](ThreadedNode*){}); }
+template <typename Fn>
+void postorder(ThreadedNode* root, Fn fn) { euler(root, [](ThreadedNode*){}, [](ThreadedNode*){}, fn); }
+
+/* Morris：cur 有左子树时找其中序前驱 pred（左子树最右），第一次到 cur 时把 pred->right 临时指回 cur，
+ * 第二次（刚从 pred 沿该指针回来）时拆掉。与经典写法的两点不同：
+ * - pred->right 原先可能就是线索（中序线索甚至正指向 cur），所以“第几次到 cur”不看指针，
+ *   而看是不是刚从 pred 过来；原值暂存在 pred->parent，拆除时还原，parent 由找 pred 时的上一个结点补回；
+ * - 没有真实右孩子的结点只有两种：某个祖先的 pred（临时指针已接好）或整棵树的最右结点 last，
+ *   走到 last 即结束，不会顺着它原有的线索跑出去。
+ * 遍历过程中 pred 们的 parent 暂时无效，回调不要依赖 parent。 */
+template <bool Preorder, typename Fn>
+void morris(ThreadedNode* root, Fn visit)
+{
+    if (!root) return;
+    ThreadedNode* last = root;
+    while (rightChild(last)) last = last->right;
+
+    ThreadedNode* cur  = root;
+    ThreadedNode* from = nullptr;
+    while (cur) {
+        if (leftChild(cur)) {
+            ThreadedNode* up   = cur;
+            ThreadedNode* pred = cur->left;
+            while (rightChild(pred)) { up = pred; pred = pred->right; }
+
+            if (from != pred) {                       // 第一次到 cur：接上临时指针，进左子树
+                if (Preorder) visit(cur);
+                pred->parent = pred->right;
+                pred->right  = cur;
+                pred->rtag   = ThreadedNode::Thread;
+                from = cur;
+                cur  = cur->left;
+                continue;
+            }
+            pred->right  = pred->parent;              // 第二次：左子树已走完，还原 pred
+            pred->rtag   = pred->right ? ThreadedNode::Thread : ThreadedNode::Child;
+            pred->parent = up;
+            if (!Preorder) visit(cur);
+        } else {
+            visit(cur);
+        }
+
+        from = cur;
+        if (rightChild(cur))  cur = cur->right;
+        else if (cur == last) break;
+        else                  cur = cur->right;       // 临时指针，回到祖先
+    }
+}
+
+template <typename Fn>
+void morrisPreorder(ThreadedNode* root, Fn fn) { morris<true>(root, fn); }
+template <typename Fn>
+void morrisInorder(ThreadedNode* root, Fn fn)  { morris<false>(root, fn); }
+
+std::vector<ThreadedNode*>& scratchStack();      // 线程内复用的栈缓冲（已清空）
+
+template <typename Fn>
+void topDown(ThreadedNode* root, Fn fn)
+{
+    if (!root) return;
+    std::vector<ThreadedNode*>& stack = scratchStack();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        ThreadedNode* p = stack.back();
+        stack.pop_back();
+        fn(p);
+        if (rightChild(p)) stack.push_back(p->right);
+        if (leftChild(p))  stack.push_back(p->left);
+    }
+}
+
+} // namespace TreeWalk
+
+#endif // TREEWALK_H
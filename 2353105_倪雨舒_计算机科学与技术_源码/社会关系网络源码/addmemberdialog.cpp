@@ -20,6 +20,21 @@ void AddMemberDialog::fillCombo(QComboBox* cb, const QStringList& items)
 }
 
 
+// 好友列表：过滤串为空时模型直接按序号列出全部（不复制），否则走姓名索引（已按相关度排好序，最多 kFilterLimit 条）
+static constexpr int kFilterLimit = 500;
+
+void AddMemberDialog::fillFriendList(const QString& filter)
+{
+    if (filter.trimmed().isEmpty()) friendModel_->showAll();
+    else                            friendModel_->setRows(graph_.searchPersons(filter, kFilterLimit));
+}
+
+void AddMemberDialog::onFilterChanged(const QString& text)
+{
+    fillFriendList(text);
+}
+
+
 
 AddMemberDialog::AddMemberDialog(SocialGraph& g, QWidget* parent)
     : QDialog(parent), graph_(g)
@@ -56,18 +71,17 @@ AddMemberDialog::AddMemberDialog(SocialGraph& g, QWidget* parent)
         form->addRow(graph_.customTitle(i) + u8"其余群组（单选）", cbCustom_[i]);   // 标题可自定义
     }
 
-    // 右侧朋友勾选（已存在的逻辑保持）
-    friendList_ = new QListWidget;
+    // 右侧朋友勾选：模型只存 id，视图只为可见行取数据，成员再多打开也不变慢
+    friendModel_ = new FriendPickerModel(graph_, this);
+    friendList_  = new QListView;
+    friendList_->setModel(friendModel_);
     friendList_->setSelectionMode(QAbstractItemView::NoSelection);
     friendList_->setUniformItemSizes(true);
-    for (PersonId id : graph_.allPersons()) {
-        const Person* p = graph_.getPerson(id);
-        if (!p) continue;
-        auto* it = new QListWidgetItem(p->name, friendList_);
-        it->setFlags(it->flags() | Qt::ItemIsUserCheckable);
-        it->setData(Qt::UserRole, QVariant::fromValue<qulonglong>(id));
-        it->setCheckState(Qt::Unchecked);
-    }
+    leFilter_ = new QLineEdit;
+    leFilter_->setPlaceholderText(u8"按姓名搜索（前缀或任意片段）");
+    leFilter_->setClearButtonEnabled(true);
+    fillFriendList(QString());
+    connect(leFilter_,   &QLineEdit::textChanged,   this, &AddMemberDialog::onFilterChanged);
 
     auto *btns = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
     connect(btns, &QDialogButtonBox::accepted, this, &AddMemberDialog::onAccept);
@@ -77,6 +91,7 @@ AddMemberDialog::AddMemberDialog(SocialGraph& g, QWidget* parent)
     layout->addWidget(wLeft, 1);
     auto *rightBox = new QVBoxLayout;
     rightBox->addWidget(new QLabel(u8"下列哪些是 TA 的好友（可多选）："));
+    rightBox->addWidget(leFilter_);
     rightBox->addWidget(friendList_, 1);
     auto *wRight = new QWidget; wRight->setLayout(rightBox);
     layout->addWidget(wRight, 1);
@@ -89,14 +104,7 @@ AddMemberDialog::AddMemberDialog(SocialGraph& g, QWidget* parent)
 
 
 QSet<PersonId> AddMemberDialog::selectedFriends() const {
-    QSet<PersonId> out;
-    for (int i=0; i<friendList_->count(); ++i) {
-        auto *it = friendList_->item(i);
-        if (it->checkState() == Qt::Checked) {
-            out.insert(static_cast<qulonglong>(it->data(Qt::UserRole).toULongLong()));
-        }
-    }
-    return out;
+    return friendModel_->checkedIds();
 }
 
 // 点 OK：组装 Person + 字段，结束
@@ -3,8 +3,9 @@
 #include <QDialog>
 #include <QComboBox>
 #include <QLineEdit>
-#include <QListWidget>
+#include <QListView>
 #include "socialgraph.h"
+#include "friendpickermodel.h"
 
 class AddMemberDialog : public QDialog
 {
@@ -19,9 +20,11 @@ public:
 
 private slots:
     void onAccept();
+    void onFilterChanged(const QString& text);
 
 private:
     static void fillCombo(QComboBox* cb, const QStringList& items);
+    void fillFriendList(const QString& filter);
 
     SocialGraph& graph_;
     Person       person_;
@@ -30,5 +33,7 @@ private:
     QComboBox *cbPrimary_, *cbMiddle_, *cbHigh_, *cbUniv_, *cbCompany_, *cbRegion_;
     QComboBox *cbCustom_[5];                 //  新增：5 个自定义群组
 
-    QListWidget* friendList_;
+    QLineEdit*   leFilter_;                  // 好友列表的实时姓名过滤
+    QListView*         friendList_;
+    FriendPickerModel* friendModel_;         // 勾选状态存在模型里，过滤换页时不丢
 };
@@ -0,0 +1,235 @@
+#include "compressedadjacency.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+void putLeb128(QByteArray& out, quint32 v)
+{
+    while (v >= 0x80) {
+        out.append(char(v | 0x80));
+        v >>= 7;
+    }
+    out.append(char(v));
+}
+
+quint32 getLeb128(const uchar*& p)
+{
+    quint32 v = 0;
+    int shift = 0;
+    for (;;) {
+        const uchar b = *p++;
+        v |= quint32(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+        shift += 7;
+    }
+}
+
+inline int byteLength(quint32 v)
+{
+    return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4;
+}
+
+// 一个好友表：度数 + group varint 编码的差分序列
+void encodeList(QByteArray& out, const std::vector<quint32>& sorted)
+{
+    putLeb128(out, quint32(sorted.size()));
+    quint32 prev = 0;
+    for (size_t i = 0; i < sorted.size(); i += 4) {
+        const size_t n = std::min<size_t>(4, sorted.size() - i);
+        const qsizetype ctrlAt = out.size();
+        out.append('\0');
+        quint8 ctrl = 0;
+        for (size_t k = 0; k < n; ++k) {
+            const quint32 d = sorted[i + k] - prev;     // 严格递增，首个值相对 0
+            prev = sorted[i + k];
+            const int len = byteLength(d);
+            ctrl |= quint8((len - 1) << (2 * k));
+            for (int b = 0; b < len; ++b) out.append(char((d >> (8 * b)) & 0xFF));
+        }
+        out[ctrlAt] = char(ctrl);
+    }
+}
+
+} // namespace
+
+CompressedAdjacency::Cursor::Cursor(const uchar* p, const uchar* end)
+    : p_(p)
+{
+    if (p_ && p_ < end) remaining_ = getLeb128(p_);
+}
+
+bool CompressedAdjacency::Cursor::next(quint32& slot)
+{
+    if (remaining_ == 0) return false;
+    if (inGroup_ == 4) { ctrl_ = *p_++; inGroup_ = 0; }
+
+    const int len = ((ctrl_ >> (2 * inGroup_)) & 3) + 1;
+    quint32 d = 0;
+    for (int b = 0; b < len; ++b) d |= quint32(p_[b]) << (8 * b);
+    p_ += len;
+    ++inGroup_;
+    --remaining_;
+
+    prev_ += d;
+    slot = prev_;
+    return true;
+}
+
+QVector<PersonId> CompressedAdjacency::computeOrder(const QHash<PersonId, QSet<PersonId>>& adj,
+                                                   VertexOrder order)
+{
+    QVector<PersonId> ids;
+    ids.reserve(adj.size());
+    for (auto it = adj.cbegin(); it != adj.cend(); ++it) ids.push_back(it.key());
+    std::sort(ids.begin(), ids.end());
+    if (order == VertexOrder::ById) return ids;
+
+    // 临时稠密下标 + 度数（按 id 升序，保证结果确定）
+    const int n = int(ids.size());
+    QHash<PersonId, int> tmp;
+    tmp.reserve(n);
+    for (int i = 0; i < n; ++i) tmp.insert(ids[i], i);
+    std::vector<int> deg(size_t(n), 0);
+    for (int i = 0; i < n; ++i) deg[size_t(i)] = int(adj.value(ids[i]).size());
+
+    auto byDegreeAsc = [&](int a, int b){ return deg[size_t(a)] != deg[size_t(b)] ? deg[size_t(a)] < deg[size_t(b)] : a < b; };
+
+    std::vector<int> perm(size_t(n));
+    for (int i = 0; i < n; ++i) perm[size_t(i)] = i;
+
+    if (order == VertexOrder::DegreeSorted) {
+        std::stable_sort(perm.begin(), perm.end(), [&](int a, int b){ return deg[size_t(a)] > deg[size_t(b)]; });
+    } else {
+        // Cuthill–McKee：每个连通分量从度数最小的点出发 BFS，邻居按度数升序入队
+        std::vector<int> seeds = perm;
+        std::sort(seeds.begin(), seeds.end(), byDegreeAsc);
+        std::vector<char> seen(size_t(n), 0);
+        std::vector<int> out, nbrs;
+        out.reserve(size_t(n));
+        for (int seed : seeds) {
+            if (seen[size_t(seed)]) continue;
+            seen[size_t(seed)] = 1;
+            size_t head = out.size();
+            out.push_back(seed);
+            while (head < out.size()) {
+                const int u = out[head++];
+                nbrs.clear();
+                for (PersonId f : adj.value(ids[u])) {
+                    const int v = tmp.value(f, -1);
+                    if (v >= 0 && !seen[size_t(v)]) { seen[size_t(v)] = 1; nbrs.push_back(v); }
+                }
+                std::sort(nbrs.begin(), nbrs.end(), byDegreeAsc);
+                out.insert(out.end(), nbrs.begin(), nbrs.end());
+            }
+        }
+        perm.assign(out.rbegin(), out.rend());   // 反转得到 RCM
+    }
+
+    QVector<PersonId> ordered;
+    ordered.reserve(n);
+    for (int i : perm) ordered.push_back(ids[i]);
+    return ordered;
+}
+
+CompressedAdjacency CompressedAdjacency::build(const QHash<PersonId, QSet<PersonId>>& adj,
+                                               VertexOrder order)
+{
+    CompressedAdjacency c;
+    c.order_ = order;
+    c.ids_   = computeOrder(adj, order);
+
+    const int n = int(c.ids_.size());
+    c.slot_.reserve(n);
+    for (int i = 0; i < n; ++i) c.slot_.insert(c.ids_[i], quint32(i));
+
+    // 按 slot 顺序依次写出各好友表：存储布局与序号顺序一致
+    c.offsets_.resize(n + 1);
+    std::vector<quint32> list;
+    for (int i = 0; i < n; ++i) {
+        c.offsets_[i] = quint32(c.data_.size());
+        list.clear();
+        for (PersonId f : adj.value(c.ids_[i])) {
+            const quint32 s = c.slot_.value(f, kNoSlot);
+            if (s != kNoSlot) list.push_back(s);
+        }
+        std::sort(list.begin(), list.end());
+        c.halfEdges_ += qint64(list.size());
+        encodeList(c.data_, list);
+    }
+    c.offsets_[n] = quint32(c.data_.size());
+    c.data_.squeeze();
+    return c;
+}
+
+CompressedAdjacency::Cursor CompressedAdjacency::cursorAt(quint32 slot) const
+{
+    if (slot >= quint32(ids_.size())) return Cursor();
+    const uchar* base = reinterpret_cast<const uchar*>(data_.constData());
+    return Cursor(base + offsets_[slot], base + offsets_[slot + 1]);
+}
+
+CompressedAdjacency::Cursor CompressedAdjacency::cursor(PersonId id) const
+{
+    return cursorAt(slotOf(id));
+}
+
+int CompressedAdjacency::degree(PersonId id) const
+{
+    return int(cursor(id).remaining());
+}
+
+int CompressedAdjacency::intersectCount(PersonId a, PersonId b) const
+{
+    Cursor ca = cursor(a), cb = cursor(b);
+    quint32 x = 0, y = 0;
+    if (!ca.next(x) || !cb.next(y)) return 0;
+
+    int count = 0;
+    for (;;) {
+        if (x == y) {
+            ++count;
+            if (!ca.next(x) || !cb.next(y)) break;
+        } else if (x < y) {
+            if (!ca.next(x)) break;
+        } else {
+            if (!cb.next(y)) break;
+        }
+    }
+    return count;
+}
+
+QSet<PersonId> CompressedAdjacency::neighbors(PersonId id) const
+{
+    QSet<PersonId> out;
+    Cursor c = cursor(id);
+    out.reserve(int(c.remaining()));
+    for (quint32 s; c.next(s); ) out.insert(ids_[s]);
+    return out;
+}
+
+QHash<PersonId, QSet<PersonId>> CompressedAdjacency::expand() const
+{
+    QHash<PersonId, QSet<PersonId>> adj;
+    adj.reserve(ids_.size());
+    for (PersonId id : ids_) adj.insert(id, neighbors(id));
+    return adj;
+}
+
+qint64 CompressedAdjacency::arrayBytes() const
+{
+    return qint64(ids_.capacity()) * qint64(sizeof(PersonId))
+         + qint64(offsets_.capacity()) * qint64(sizeof(quint32))
+         + qint64(data_.capacity());
+}
+
+double CompressedAdjacency::meanNeighborGap() const
+{
+    if (halfEdges_ == 0) return 0.0;
+    double sum = 0.0;
+    for (quint32 u = 0; u < quint32(ids_.size()); ++u) {
+        Cursor c = cursorAt(u);
+        for (quint32 v; c.next(v); ) sum += (v > u) ? double(v - u) : double(u - v);
+    }
+    return sum / double(halfEdges_);
+}
@@ -0,0 +1,93 @@
+// compressedadjacency.h
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QByteArray>
+#include <QtGlobal>
+
+using PersonId = quint64;
+
+/**
+ * 只读的压缩邻接表（冷数据用）：
+ * - 每人分配一个稠密的内部序号 slot，好友表存 slot 而不是 64 位 PersonId；
+ * - 每个好友表按 slot 升序排序后做差分，再用 group varint 编码：
+ *   [度数 LEB128] + 若干组 { 1 字节控制位（每值 2 bit = 字节数-1）, 最多 4 个差值 }；
+ * - 遍历时用 Cursor 边读边解码，不展开成集合；求交集直接在两条有序流上归并。
+ * 构造后不可修改；图需要写入时由 SocialGraph 展开回 QHash/QSet 形式。
+ *
+ * 内部序号的分配顺序即存储顺序（offsets_/data_ 按 slot 排列），可选：
+ * - ById：按 PersonId 升序（即插入顺序）；
+ * - DegreeSorted：度数降序，高频访问的“大 V”集中在表头；
+ * - ReverseCuthillMcKee：按连通分量做 BFS（邻居按度数升序入队）再整体反转，
+ *   使相邻的人拿到相近的序号——遍历时内存访问更集中，差分也更小、压缩更好。
+ * 外部看到的 PersonId 不变，slot_/ids_ 就是双向翻译表。
+ */
+class CompressedAdjacency
+{
+public:
+    enum class VertexOrder { ById, DegreeSorted, ReverseCuthillMcKee };
+
+    CompressedAdjacency() = default;
+
+    static CompressedAdjacency build(const QHash<PersonId, QSet<PersonId>>& adj,
+                                     VertexOrder order = VertexOrder::ReverseCuthillMcKee);
+
+    // 流式解码一个好友表；next() 依次给出升序的内部序号
+    class Cursor
+    {
+    public:
+        Cursor() = default;
+        Cursor(const uchar* p, const uchar* end);
+
+        bool    next(quint32& slot);
+        quint32 remaining() const { return remaining_; }
+
+    private:
+        const uchar* p_ = nullptr;
+        quint32 remaining_ = 0;
+        quint32 prev_      = 0;
+        quint8  ctrl_      = 0;
+        int     inGroup_   = 4;      // 4 表示需要读下一个控制字节
+    };
+
+    int      vertexCount() const { return int(ids_.size()); }
+    bool     contains(PersonId id) const { return slot_.contains(id); }
+    int      degree(PersonId id) const;
+    Cursor   cursor(PersonId id) const;
+    Cursor   cursorAt(quint32 slot) const;
+    PersonId idAt(quint32 slot) const { return ids_[slot]; }
+    quint32  slotOf(PersonId id) const { return slot_.value(id, kNoSlot); }
+
+    template <typename Fn>
+    void forEachNeighbor(PersonId id, Fn&& fn) const
+    {
+        Cursor c = cursor(id);
+        for (quint32 s; c.next(s); ) fn(ids_[s]);
+    }
+
+    int            intersectCount(PersonId a, PersonId b) const;   // 有序流归并
+    QSet<PersonId> neighbors(PersonId id) const;                   // 解码成集合（给 UI）
+    QHash<PersonId, QSet<PersonId>> expand() const;                // 还原成可写形式
+    qint64         edgeCount() const { return halfEdges_ / 2; }
+
+    // 内存统计用
+    const QHash<PersonId, quint32>& slotMap() const { return slot_; }
+    qint64 arrayBytes() const;
+    double meanNeighborGap() const;   // 好友之间 |slot 差| 的均值：越小局部性越好
+    VertexOrder order() const { return order_; }
+
+    static constexpr quint32 kNoSlot = 0xFFFFFFFFu;
+
+private:
+    QHash<PersonId, quint32> slot_;   // PersonId -> 内部序号
+    QVector<PersonId>        ids_;    // 内部序号 -> PersonId
+    QVector<quint32>         offsets_;// 内部序号 -> data_ 中的起始字节，末尾多一个哨兵
+    QByteArray               data_;
+    qint64                   halfEdges_ = 0;
+    VertexOrder              order_ = VertexOrder::ById;
+
+    static QVector<PersonId> computeOrder(const QHash<PersonId, QSet<PersonId>>& adj,
+                                          VertexOrder order);
+};
@@ -0,0 +1,410 @@
+#include "csvimporter.h"
+#include <QFile>
+#include <QThread>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr qint64  kChunkBytes = 4 << 20;       // 每块约 4 MiB，块边界对齐到行尾
+constexpr quint32 kEscaped    = 0x80000000u;   // Field::len 最高位：字段含 "" 转义
+
+using Field = CsvImporter::Field;
+
+struct Chunk {
+    qint64 begin = 0;
+    qint64 end   = 0;
+    int    rows  = 0;
+    std::vector<Field> fields;                 // 成员表：rows * SlotCount 个
+    QVector<QPair<PersonId, PersonId>> edges;  // 边表：已解析出的好友对
+};
+
+// 整个文件映射进内存；映射失败（如空文件、特殊设备）时退回 readAll
+struct MappedFile {
+    QFile       file;
+    QByteArray  fallback;
+    const char* data = nullptr;
+    qint64      size = 0;
+
+    bool open(const QString& path, QString& err)
+    {
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            err = QStringLiteral("无法打开文件：%1").arg(path);
+            return false;
+        }
+        size = file.size();
+        if (size > 0) {
+            if (uchar* m = file.map(0, size)) {
+                data = reinterpret_cast<const char*>(m);
+                return true;
+            }
+        }
+        fallback = file.readAll();
+        data = fallback.constData();
+        size = fallback.size();
+        return true;
+    }
+
+    // 跳过 UTF-8 BOM，返回正文起点
+    qint64 bodyStart() const
+    {
+        if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) return 3;
+        return 0;
+    }
+};
+
+inline const char* lineEnd(const char* p, const char* e)
+{
+    const void* nl = std::memchr(p, '\n', size_t(e - p));
+    return nl ? static_cast<const char*>(nl) : e;
+}
+
+// 按行边界把 [begin, size) 切成若干块
+std::vector<Chunk> makeChunks(const char* data, qint64 begin, qint64 size)
+{
+    std::vector<Chunk> chunks;
+    qint64 pos = begin;
+    while (pos < size) {
+        qint64 cut = qMin(size, pos + kChunkBytes);
+        if (cut < size) cut = lineEnd(data + cut, data + size) - data + 1;
+        Chunk c;
+        c.begin = pos;
+        c.end   = qMin(cut, size);
+        chunks.push_back(std::move(c));
+        pos = cut;
+    }
+    return chunks;
+}
+
+// 拆一行：对每个字段回调 fn(col, begin, end, escaped)；end 不含分隔符/引号，已去首尾空白
+template <typename Fn>
+void splitLine(const char* p, const char* e, char sep, Fn&& fn)
+{
+    int col = 0;
+    for (;;) {
+        while (p < e && *p == ' ') ++p;
+        const char* s = p;
+        const char* t = p;
+        bool escaped = false;
+        if (p < e && *p == '"') {
+            s = ++p;
+            while (p < e) {
+                if (*p == '"') {
+                    if (p + 1 < e && p[1] == '"') { escaped = true; p += 2; continue; }
+                    break;
+                }
+                ++p;
+            }
+            t = p;
+            while (p < e && *p != sep) ++p;
+        } else {
+            while (p < e && *p != sep) ++p;
+            t = p;
+            while (t > s && (t[-1] == ' ' || (t[-1] == '\t' && sep != '\t'))) --t;
+        }
+        fn(col++, s, t, escaped);
+        if (p >= e) break;
+        ++p;                                   // 越过分隔符；行尾的空字段也会回调一次
+    }
+}
+
+// 表头里出现最多的分隔符（, ; \t）
+char detectSeparator(const char* p, const char* e)
+{
+    int comma = 0, semi = 0, tab = 0;
+    for (; p < e; ++p) {
+        if (*p == ',') ++comma;
+        else if (*p == ';') ++semi;
+        else if (*p == '\t') ++tab;
+    }
+    if (tab > comma && tab > semi) return '\t';
+    if (semi > comma) return ';';
+    return ',';
+}
+
+inline const char* stripCr(const char* s, const char* e)
+{
+    return (e > s && e[-1] == '\r') ? e - 1 : e;
+}
+
+QByteArray unescape(QByteArrayView v)
+{
+    QByteArray out;
+    out.reserve(v.size());
+    for (qsizetype i = 0; i < v.size(); ++i) {
+        out.append(v[i]);
+        if (v[i] == '"' && i + 1 < v.size() && v[i + 1] == '"') ++i;
+    }
+    return out;
+}
+
+// 纯数字 id 解析（最多 19 位，避免溢出）
+bool parseNumber(QByteArrayView v, quint64& out)
+{
+    if (v.isEmpty() || v.size() > 19) return false;
+    quint64 n = 0;
+    for (char c : v) {
+        if (c < '0' || c > '9') return false;
+        n = n * 10 + quint64(c - '0');
+    }
+    out = n;
+    return true;
+}
+
+// 多线程跑完所有块；主线程也参与解析，并在每完成一块后上报进度
+template <typename Fn, typename Progress>
+void runChunks(std::vector<Chunk>& chunks, Fn&& parse, Progress&& report)
+{
+    std::atomic<size_t> next{0};
+    std::atomic<qint64> bytesDone{0};
+    auto worker = [&]{
+        for (size_t i; (i = next.fetch_add(1)) < chunks.size(); ) {
+            parse(chunks[i]);
+            bytesDone += chunks[i].end - chunks[i].begin;
+        }
+    };
+
+    const int extra = qMin<int>(qMax(1, QThread::idealThreadCount()) - 1,
+                                int(chunks.size()) - 1);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < extra; ++t) pool.emplace_back(worker);
+
+    for (size_t i; (i = next.fetch_add(1)) < chunks.size(); ) {
+        parse(chunks[i]);
+        report(bytesDone += chunks[i].end - chunks[i].begin);
+    }
+    for (auto& th : pool) th.join();
+    report(bytesDone.load());
+}
+
+} // namespace
+
+CsvImporter::CsvImporter(SocialGraph& g, QObject* parent)
+    : QObject(parent), graph_(g)
+{
+}
+
+int CsvImporter::columnSlot(QByteArrayView header)
+{
+    const QString h = QString::fromUtf8(header).trimmed().toCaseFolded();
+    static const QHash<QString, int> names = {
+        {"id", SlotId},                 {"编号", SlotId},
+        {"name", SlotName},             {"姓名", SlotName},
+        {"region", SlotRegion},         {"地区", SlotRegion},
+        {"primaryschool", SlotPrimary}, {"小学", SlotPrimary},
+        {"middleschool", SlotMiddle},   {"中学", SlotMiddle},
+        {"highschool", SlotHigh},       {"高中", SlotHigh},
+        {"university", SlotUniv},       {"大学", SlotUniv},
+        {"company", SlotCompany},       {"工作单位", SlotCompany},
+        {"custom1", SlotCustom1}, {"custom2", SlotCustom2}, {"custom3", SlotCustom3},
+        {"custom4", SlotCustom4}, {"custom5", SlotCustom5},
+    };
+    return names.value(h, -1);
+}
+
+GroupType CsvImporter::slotGroupType(int slot)
+{
+    switch (slot) {
+    case SlotRegion:  return GroupType::Region;
+    case SlotPrimary: return GroupType::PrimarySchool;
+    case SlotMiddle:  return GroupType::MiddleSchool;
+    case SlotHigh:    return GroupType::HighSchool;
+    case SlotUniv:    return GroupType::University;
+    case SlotCompany: return GroupType::Company;
+    default:
+        return static_cast<GroupType>(static_cast<int>(GroupType::Custom1) + (slot - SlotCustom1));
+    }
+}
+
+PersonId CsvImporter::lookupExternal(QByteArrayView key) const
+{
+    quint64 n = 0;
+    if (parseNumber(key, n)) return numericIds_.value(n, 0);
+    return textIds_.value(QByteArray::fromRawData(key.data(), key.size()), 0);
+}
+
+void CsvImporter::rememberExternal(QByteArrayView key, PersonId pid)
+{
+    quint64 n = 0;
+    if (parseNumber(key, n)) numericIds_.insert(n, pid);
+    else                     textIds_.insert(key.toByteArray(), pid);
+}
+
+bool CsvImporter::importMembers(const QString& csvPath)
+{
+    persons_ = 0;
+    error_.clear();
+
+    MappedFile mf;
+    if (!mf.open(csvPath, error_)) return false;
+    const char* data = mf.data;
+    const qint64 size = mf.size;
+    const qint64 total = size * 2;
+
+    // 1) 表头：确定分隔符与 列 → 槽位 的映射
+    const qint64 hBegin = mf.bodyStart();
+    const char* hEnd = lineEnd(data + hBegin, data + size);
+    const char* hStop = stripCr(data + hBegin, hEnd);
+    const char sep = detectSeparator(data + hBegin, hStop);
+
+    QVector<int> colToSlot;
+    splitLine(data + hBegin, hStop, sep, [&](int, const char* s, const char* t, bool){
+        colToSlot.push_back(columnSlot(QByteArrayView(s, t - s)));
+    });
+    if (!colToSlot.contains(SlotName)) {
+        error_ = QStringLiteral("表头缺少“姓名/name”列");
+        return false;
+    }
+    const bool hasIdColumn = colToSlot.contains(SlotId);
+    const qint64 bodyBegin = qMin<qint64>(size, hEnd - data + 1);
+
+    // 2) 并行解析：每块只记录字段偏移（工作线程只读 slotOf）
+    const QVector<int>& slotOf = colToSlot;
+    std::vector<Chunk> chunks = makeChunks(data, bodyBegin, size);
+    runChunks(chunks, [&](Chunk& c){
+        const char* base = data + c.begin;
+        const char* e    = data + c.end;
+        c.fields.reserve(size_t((c.end - c.begin) / 64 + 1) * SlotCount);
+        for (const char* p = base; p < e; ) {
+            const char* le = lineEnd(p, e);
+            const char* stop = stripCr(p, le);
+            if (stop > p) {
+                const size_t row = c.fields.size();
+                c.fields.resize(row + SlotCount);
+                splitLine(p, stop, sep, [&](int col, const char* s, const char* t, bool esc){
+                    if (col >= slotOf.size() || slotOf[col] < 0) return;
+                    Field& f = c.fields[row + size_t(slotOf[col])];
+                    f.off = quint32(s - base);
+                    f.len = quint32(t - s) | (esc ? kEscaped : 0u);
+                });
+                ++c.rows;
+            }
+            p = le + 1;
+        }
+    }, [&](qint64 done){ emit progress(done, total); });
+
+    // 3) 顺序写入：人员表 → 外部 id 表 → 组织倒排
+    int totalRows = 0;
+    for (const Chunk& c : chunks) totalRows += c.rows;
+    graph_.reserve(graph_.personCount() + totalRows);
+
+    // 属性值驻留：同一个学校/公司名只生成一次 QString，并缓存其 GroupId
+    struct Interned { QString text; GroupId gid = 0; };
+    QHash<QByteArrayView, Interned> pool[SlotCount];
+
+    auto text = [&](const char* base, const Field& f)->QString {
+        const QByteArrayView v(base + f.off, qsizetype(f.len & ~kEscaped));
+        return (f.len & kEscaped) ? QString::fromUtf8(unescape(v)) : QString::fromUtf8(v);
+    };
+
+    int rowNo = 0;
+    qint64 merged = size;
+    for (const Chunk& c : chunks) {
+        const char* base = data + c.begin;
+        for (int r = 0; r < c.rows; ++r) {
+            const Field* f = c.fields.data() + size_t(r) * SlotCount;
+            ++rowNo;
+
+            Person p;
+            p.name = text(base, f[SlotName]);
+            if (p.name.isEmpty()) continue;
+
+            GroupId gids[SlotCount] = {};
+            for (int s = SlotRegion; s < SlotCount; ++s) {
+                if ((f[s].len & ~kEscaped) == 0) continue;
+                QString value;
+                if (f[s].len & kEscaped) {
+                    value = text(base, f[s]);
+                    gids[s] = graph_.findOrCreateGroupByName(value, slotGroupType(s));
+                } else {
+                    const QByteArrayView key(base + f[s].off, qsizetype(f[s].len));
+                    auto it = pool[s].find(key);
+                    if (it == pool[s].end()) {
+                        Interned in;
+                        in.text = QString::fromUtf8(key);
+                        in.gid  = graph_.findOrCreateGroupByName(in.text, slotGroupType(s));
+                        it = pool[s].insert(key, in);
+                    }
+                    value   = it->text;
+                    gids[s] = it->gid;
+                }
+                switch (s) {
+                case SlotRegion:  p.region        = value; break;
+                case SlotPrimary: p.primarySchool = value; break;
+                case SlotMiddle:  p.middleSchool  = value; break;
+                case SlotHigh:    p.highSchool    = value; break;
+                case SlotUniv:    p.university    = value; break;
+                case SlotCompany: p.company       = value; break;
+                default:          p.custom[s - SlotCustom1] = value; break;
+                }
+            }
+
+            const PersonId pid = graph_.addPerson(p);
+            for (int s = SlotRegion; s < SlotCount; ++s)
+                if (gids[s]) graph_.addMembership(pid, gids[s]);
+
+            // 有 id 列时 id 为空的行不登记：行号可能与别的行的真实数字 id 相同，会把边连错人
+            if (!hasIdColumn)
+                numericIds_.insert(quint64(rowNo), pid);
+            else if (f[SlotId].len & ~kEscaped)
+                rememberExternal(QByteArrayView(base + f[SlotId].off,
+                                                qsizetype(f[SlotId].len & ~kEscaped)), pid);
+            ++persons_;
+        }
+        merged += c.end - c.begin;
+        emit progress(merged, total);
+    }
+    emit progress(total, total);
+    return true;
+}
+
+bool CsvImporter::importFriendships(const QString& edgePath)
+{
+    edges_ = 0;
+    error_.clear();
+
+    MappedFile mf;
+    if (!mf.open(edgePath, error_)) return false;
+    const char* data = mf.data;
+    const qint64 size = mf.size;
+    const qint64 total = size * 2;
+
+    // 并行解析 + 解析 id（此阶段只读 id 表，可多线程共享）
+    std::vector<Chunk> chunks = makeChunks(data, mf.bodyStart(), size);
+    runChunks(chunks, [&](Chunk& c){
+        const char* e = data + c.end;
+        for (const char* p = data + c.begin; p < e; ) {
+            const char* le = lineEnd(p, e);
+            const char* stop = stripCr(p, le);
+
+            // 取前两个记号；分隔符可以是 , ; 制表符 或空格，引号会被去掉
+            QByteArrayView tok[2];
+            int n = 0;
+            for (const char* q = p; q < stop && n < 2; ) {
+                while (q < stop && std::strchr(",; \t\"", *q)) ++q;
+                const char* s = q;
+                while (q < stop && !std::strchr(",; \t\"", *q)) ++q;
+                if (q > s) tok[n++] = QByteArrayView(s, q - s);
+            }
+            if (n == 2) {
+                const PersonId a = lookupExternal(tok[0]);
+                const PersonId b = lookupExternal(tok[1]);
+                if (a && b && a != b) c.edges.push_back({a, b});   // 表头/未知 id 自然被跳过
+            }
+            p = le + 1;
+        }
+    }, [&](qint64 done){ emit progress(done, total); });
+
+    qint64 merged = size;
+    for (const Chunk& c : chunks) {
+        for (const auto& e : c.edges)
+            if (graph_.addFriendship(e.first, e.second)) ++edges_;
+        merged += c.end - c.begin;
+        emit progress(merged, total);
+    }
+    emit progress(total, total);
+    return true;
+}
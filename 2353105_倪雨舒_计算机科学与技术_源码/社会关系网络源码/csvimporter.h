@@ -0,0 +1,66 @@
+// csvimporter.h
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QByteArray>
+#include "socialgraph.h"
+
+/**
+ * 批量导入：成员 CSV + 好友边表
+ * - 成员 CSV：首行为表头，一行一人；列名见 columnSlot()（中英文都认）
+ * - 边表：每行 "a,b"（分隔符可为 , ; 制表符 空格），a/b 为成员 CSV 里的 id 列；
+ *   成员 CSV 没有 id 列时按数据行号（从 1 开始）编号；有 id 列但某行 id 为空，则该行不能被边表引用
+ *
+ * 实现要点：文件整体内存映射 → 按行边界切块 → 多线程并行解析（只记录字段偏移，
+ * 不为每个字段分配 QString）→ 主线程顺序写入 SocialGraph 的人员表与组织倒排。
+ * 重复出现的学校/公司/地区等只创建一次 QString，并借助隐式共享复用给所有成员。
+ * 约定：带引号的字段内不允许出现换行（切块只看行边界）。
+ */
+class CsvImporter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CsvImporter(SocialGraph& g, QObject* parent = nullptr);
+
+    bool importMembers(const QString& csvPath);       // 成员表：新增成员并加入对应群组
+    bool importFriendships(const QString& edgePath);  // 边表：依赖先前导入的成员 id
+
+    int     importedPersons() const { return persons_; }
+    int     importedEdges()   const { return edges_; }
+    QString errorString()     const { return error_; }
+
+    // 字段槽位：成员 CSV 的列统一映射到这里
+    enum Slot : int {
+        SlotId = 0, SlotName, SlotRegion,
+        SlotPrimary, SlotMiddle, SlotHigh, SlotUniv, SlotCompany,
+        SlotCustom1, SlotCustom2, SlotCustom3, SlotCustom4, SlotCustom5,
+        SlotCount
+    };
+
+    // 字段位置：相对所在块起点的偏移 + 长度（最高位表示含 "" 转义，需要还原）
+    struct Field {
+        quint32 off = 0;
+        quint32 len = 0;
+    };
+
+signals:
+    // done/total 以字节计；解析阶段和写入阶段各占一半
+    void progress(qint64 done, qint64 total);
+
+private:
+    static int       columnSlot(QByteArrayView header);
+    static GroupType slotGroupType(int slot);
+    PersonId         lookupExternal(QByteArrayView key) const;
+    void             rememberExternal(QByteArrayView key, PersonId pid);
+
+    SocialGraph& graph_;
+    int     persons_ = 0;
+    int     edges_   = 0;
+    QString error_;
+
+    // 外部 id → PersonId：纯数字走整数表，其余走字节串表
+    QHash<quint64,    PersonId> numericIds_;
+    QHash<QByteArray, PersonId> textIds_;
+};
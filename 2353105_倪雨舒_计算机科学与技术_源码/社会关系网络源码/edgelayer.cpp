@@ -0,0 +1,214 @@
+#include "edgelayer.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include "nodeitem.h"
+
+EdgeLayer::EdgeLayer(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , pen_(QColor(138, 84, 28), 3)              // 棕色线
+    , highlightPen_(QColor(220, 60, 60), 3)
+    , thinPen_(QColor(138, 84, 28, 70), 1)
+    , thinHighlightPen_(QColor(220, 60, 60), 2)
+{
+    thinPen_.setCosmetic(true);
+    thinHighlightPen_.setCosmetic(true);
+    setZValue(0);
+    setAcceptedMouseButtons(Qt::NoButton);
+    setFlag(ItemUsesExtendedStyleOption, true);  // 需要 exposedRect 做裁剪
+}
+
+void EdgeLayer::reserve(int edgeCount)
+{
+    ends_.reserve(edgeCount);
+    lines_.reserve(edgeCount);
+    slot_.reserve(edgeCount);
+}
+
+void EdgeLayer::growBounds(const QLineF& l)
+{
+    const QRectF r = QRectF(l.p1(), l.p2()).normalized().adjusted(-4, -4, 4, 4);
+    if (bounds_.contains(r)) return;
+    prepareGeometryChange();
+    bounds_ = bounds_.isNull() ? r : bounds_.united(r);
+}
+
+bool EdgeLayer::addEdge(PersonId a, PersonId b, const QPointF& pa, const QPointF& pb)
+{
+    const Key k = key(a, b);
+    if (a == b || slot_.contains(k)) return false;
+    const QLineF l = (k.first == a) ? QLineF(pa, pb) : QLineF(pb, pa);
+
+    const int i = int(ends_.size());
+    ends_.push_back(k);
+    lines_.push_back(l);
+    slot_.insert(k, i);
+    incident_[a].push_back(i);
+    incident_[b].push_back(i);
+    bucketInsert(i);
+    growBounds(l);
+    update(QRectF(l.p1(), l.p2()).normalized().adjusted(-4, -4, 4, 4));
+    return true;
+}
+
+bool EdgeLayer::removeEdge(PersonId a, PersonId b)
+{
+    const Key k = key(a, b);
+    auto it = slot_.find(k);
+    if (it == slot_.end()) return false;
+    const int i = it.value();
+    slot_.erase(it);
+    const QRectF dirty = QRectF(lines_[i].p1(), lines_[i].p2()).normalized().adjusted(-4, -4, 4, 4);
+
+    incident_[k.first].removeOne(i);
+    incident_[k.second].removeOne(i);
+    bucketRemove(i);
+
+    // 末尾那条挪到 i，修正它在两端 incident_ 里的下标
+    const int last = int(ends_.size()) - 1;
+    if (i != last) {
+        const Key moved = ends_[last];
+        bucketRemove(last);
+        ends_[i]  = moved;
+        lines_[i] = lines_[last];
+        slot_[moved] = i;
+        bucketInsert(i);
+        for (PersonId end : { moved.first, moved.second }) {
+            QVector<int>& v = incident_[end];
+            const qsizetype pos = v.indexOf(last);
+            if (pos >= 0) v[pos] = i;
+        }
+    }
+    ends_.removeLast();
+    lines_.removeLast();
+    update(dirty);
+    return true;
+}
+
+void EdgeLayer::removeNode(PersonId id)
+{
+    const QVector<int> mine = incident_.value(id);       // 拷贝：removeEdge 会改动
+    QVector<Key> keys;
+    keys.reserve(mine.size());
+    for (int i : mine) keys.push_back(ends_[i]);
+    for (const Key& k : keys) removeEdge(k.first, k.second);
+    incident_.remove(id);
+}
+
+void EdgeLayer::nodeMoved(PersonId id, const QPointF& p)
+{
+    auto it = incident_.constFind(id);
+    if (it == incident_.cend()) return;
+    for (int i : *it) {
+        QLineF& l = lines_[i];
+        const QRectF before = QRectF(l.p1(), l.p2()).normalized();
+        bucketRemove(i);
+        if (ends_[i].first == id) l.setP1(p);
+        else                      l.setP2(p);
+        bucketInsert(i);
+        growBounds(l);
+        update(before.united(QRectF(l.p1(), l.p2()).normalized()).adjusted(-4, -4, 4, 4));
+    }
+}
+
+void EdgeLayer::setHighlight(PersonId id)
+{
+    if (highlight_ == id) return;
+    for (PersonId who : { highlight_, id }) {
+        for (int i : incident_.value(who))
+            update(QRectF(lines_[i].p1(), lines_[i].p2()).normalized().adjusted(-4, -4, 4, 4));
+    }
+    highlight_ = id;
+}
+
+void EdgeLayer::bucketInsert(int i)
+{
+    forEachCell(lines_[i], [&](quint64 c){ buckets_[c].push_back(i); });
+}
+
+// 与 bucketInsert 用同一条线段算格子，结果完全一致
+void EdgeLayer::bucketRemove(int i)
+{
+    forEachCell(lines_[i], [&](quint64 c){
+        auto it = buckets_.find(c);
+        if (it == buckets_.end()) return;
+        it->removeOne(i);
+        if (it->isEmpty()) buckets_.erase(it);
+    });
+}
+
+// 点到线段距离，只比较点附近格子里的边；由点击处理代码按需调用
+int EdgeLayer::edgeAt(const QPointF& scenePos, qreal tolerance) const
+{
+    const qreal tol2 = tolerance * tolerance;
+    int best = -1;
+    qreal bestD2 = tol2;
+    const int x0 = cellOf(scenePos.x() - tolerance), x1 = cellOf(scenePos.x() + tolerance);
+    const int y0 = cellOf(scenePos.y() - tolerance), y1 = cellOf(scenePos.y() + tolerance);
+    for (int cx = x0; cx <= x1; ++cx) {
+        for (int cy = y0; cy <= y1; ++cy) {
+            auto c = buckets_.constFind(SpatialGrid::key(cx, cy));
+            if (c == buckets_.cend()) continue;
+            for (int i : *c) {
+                const QLineF& l = lines_[i];
+                const QPointF d = l.p2() - l.p1();
+                const qreal len2 = d.x() * d.x() + d.y() * d.y();
+                qreal t = len2 > 0 ? QPointF::dotProduct(scenePos - l.p1(), d) / len2 : 0;
+                t = qBound<qreal>(0, t, 1);
+                const QPointF q = l.p1() + t * d - scenePos;
+                const qreal d2 = q.x() * q.x() + q.y() * q.y();
+                if (d2 <= bestD2) { bestD2 = d2; best = i; }
+            }
+        }
+    }
+    return best;
+}
+
+void EdgeLayer::paint(QPainter* p, const QStyleOptionGraphicsItem* opt, QWidget*)
+{
+    const QRectF view = opt->exposedRect.adjusted(-4, -4, 4, 4);
+    visible_.clear();
+    visibleHi_.clear();
+
+    // 线段包围盒与重绘区相交才画；与高亮的人相连的边只进高亮那一批
+    auto take = [&](int i){
+        const QLineF& l = lines_[i];
+        if (qMax(l.x1(), l.x2()) < view.left() || qMin(l.x1(), l.x2()) > view.right() ||
+            qMax(l.y1(), l.y2()) < view.top()  || qMin(l.y1(), l.y2()) > view.bottom())
+            return;
+        const bool hi = highlight_ && (ends_[i].first == highlight_ || ends_[i].second == highlight_);
+        (hi ? visibleHi_ : visible_).push_back(l);
+    };
+
+    const int x0 = cellOf(view.left()), x1 = cellOf(view.right());
+    const int y0 = cellOf(view.top()),  y1 = cellOf(view.bottom());
+    if (qint64(x1 - x0 + 1) * qint64(y1 - y0 + 1) > qint64(buckets_.size())) {
+        // 重绘区覆盖的格子比非空格子还多（缩得很小），几乎全部可见，直接顺序扫
+        for (int i = 0; i < lines_.size(); ++i) take(i);
+    } else {
+        // 一条边会登记在多个格子里，用 stamp_ 去重
+        if (seen_.size() < lines_.size()) seen_.resize(lines_.size());
+        if (++stamp_ == 0) { seen_.fill(0); stamp_ = 1; }
+        for (int cx = x0; cx <= x1; ++cx) {
+            for (int cy = y0; cy <= y1; ++cy) {
+                auto c = buckets_.constFind(SpatialGrid::key(cx, cy));
+                if (c == buckets_.cend()) continue;
+                for (int i : *c) {
+                    if (seen_[i] == stamp_) continue;
+                    seen_[i] = stamp_;
+                    take(i);
+                }
+            }
+        }
+    }
+
+    // 缩小后改用 1 像素宽的半透明细线（cosmetic，不随缩放变粗细），密集处靠叠加显出深浅
+    const qreal lod = opt->levelOfDetailFromTransform(p->worldTransform());
+    const bool thin = lod < NodeItem::kPointLod;
+    p->setRenderHint(QPainter::Antialiasing, !thin);
+    p->setPen(thin ? thinPen_ : pen_);
+    p->drawLines(visible_);
+    if (!visibleHi_.isEmpty()) {
+        p->setPen(thin ? thinHighlightPen_ : highlightPen_);
+        p->drawLines(visibleHi_);
+    }
+}
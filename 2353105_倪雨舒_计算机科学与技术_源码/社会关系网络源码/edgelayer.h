@@ -0,0 +1,84 @@
+#pragma once
+#include <QGraphicsItem>
+#include <QHash>
+#include <QLineF>
+#include <QPair>
+#include <QPainterPath>
+#include <QPen>
+#include <QVector>
+#include "socialgraph.h"
+#include "spatialgrid.h"
+
+/**
+ * 全部好友边合成一个图元：
+ * - 几何放在扁平数组里（端点 id + 线段），另有 “人 -> 所连边下标” 表，
+ *   节点移动时只改它那几条边；删边用“与末尾交换”保持数组紧凑；
+ * - 另按 SpatialGrid 的格子编码把每条边登记到它穿过的格子里，
+ *   paint 只看与重绘区域相交的格子，裁剪代价随可见的边数而不是总边数增长；
+ *   每种样式一次 drawLines，缩小到 NodeItem::kPointLod 以下时换成细的半透明线、关掉抗锯齿；
+ * - shape() 为空，场景的鼠标命中测试不会落到它身上；要点中某条边时由点击处理代码调用 edgeAt()，
+ *   它同样只查点所在的格子。
+ */
+class EdgeLayer : public QGraphicsItem
+{
+public:
+    explicit EdgeLayer(QGraphicsItem* parent = nullptr);
+
+    void reserve(int edgeCount);
+    bool addEdge(PersonId a, PersonId b, const QPointF& pa, const QPointF& pb);
+    bool removeEdge(PersonId a, PersonId b);
+    void removeNode(PersonId id);                       // 删掉与之相连的全部边
+    void nodeMoved(PersonId id, const QPointF& p);      // 只更新相连的那一段
+    void setHighlight(PersonId id);                     // 与该人相连的边用高亮样式
+
+    int  edgeCount() const { return int(ends_.size()); }
+    bool contains(PersonId a, PersonId b) const { return slot_.contains(key(a, b)); }
+    QPair<PersonId, PersonId> endsAt(int i) const { return ends_[i]; }
+    int  edgeAt(const QPointF& scenePos, qreal tolerance = 4.0) const;   // 命中的边下标，-1 表示没有
+
+    QRectF       boundingRect() const override { return bounds_; }
+    QPainterPath shape() const override { return QPainterPath(); }
+    void         paint(QPainter* p, const QStyleOptionGraphicsItem* opt, QWidget*) override;
+
+private:
+    using Key = QPair<PersonId, PersonId>;
+    static constexpr qreal kCell = 180.0;               // 分桶格子边长（两倍节点间距）
+    static Key key(PersonId a, PersonId b) { return a < b ? qMakePair(a, b) : qMakePair(b, a); }
+    static int cellOf(qreal v) { return int(qFloor(v / kCell)); }
+    void growBounds(const QLineF& l);
+    void bucketInsert(int i);                            // 把第 i 条边登记到它穿过的格子
+    void bucketRemove(int i);
+
+    // 线段穿过的每个格子调用一次 fn(格子键)：逐列求出线段在该列里的 y 范围
+    template <typename Fn>
+    static void forEachCell(const QLineF& l, Fn fn)
+    {
+        QPointF a = l.p1(), b = l.p2();
+        if (a.x() > b.x()) qSwap(a, b);
+        const qreal dx = b.x() - a.x(), dy = b.y() - a.y();
+        const int cx0 = cellOf(a.x()), cx1 = cellOf(b.x());
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            qreal ya = a.y(), yb = b.y();
+            if (cx0 != cx1) {
+                const qreal xl = qMax(a.x(), cx * kCell), xr = qMin(b.x(), (cx + 1) * kCell);
+                ya = a.y() + dy * (xl - a.x()) / dx;
+                yb = a.y() + dy * (xr - a.x()) / dx;
+            }
+            const int cy1 = cellOf(qMax(ya, yb));
+            for (int cy = cellOf(qMin(ya, yb)); cy <= cy1; ++cy) fn(SpatialGrid::key(cx, cy));
+        }
+    }
+
+    QVector<Key>                   ends_;      // 第 i 条边的两端（小 id, 大 id）
+    QVector<QLineF>                lines_;     // 第 i 条边的线段，p1 对应 ends_[i].first
+    QHash<Key, int>                slot_;      // 端点 -> 下标
+    QHash<PersonId, QVector<int>>  incident_;  // 人 -> 相连边的下标
+    QRectF                         bounds_;
+    PersonId                       highlight_ = 0;
+    QPen                           pen_, highlightPen_;
+    QPen                           thinPen_, thinHighlightPen_;   // 低细节层次用
+    QHash<quint64, QVector<int>>   buckets_;   // 格子 -> 穿过它的边的下标
+    QVector<quint32>               seen_;      // 本次 paint 是否已看过第 i 条（与 stamp_ 比较，跨格子去重）
+    quint32                        stamp_ = 0;
+    QVector<QLineF>                visible_, visibleHi_;   // paint 复用的缓冲
+};
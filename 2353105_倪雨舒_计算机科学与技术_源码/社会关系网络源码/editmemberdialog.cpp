@@ -22,6 +22,26 @@ void EditMemberDialog::fillCombo(QComboBox* cb, const QStringList& items)
 }
 
 
+// 好友列表：过滤串为空时模型直接按序号列出全部（不复制），否则走姓名索引（已按相关度排好序，最多 kFilterLimit 条）
+static constexpr int kFilterLimit = 500;
+
+void EditMemberDialog::fillFriendList(const QString& filter)
+{
+    if (filter.trimmed().isEmpty()) {
+        friendModel_->showAll(id_);
+        return;
+    }
+    QVector<PersonId> ids = graph_.searchPersons(filter, kFilterLimit);
+    ids.removeOne(id_);
+    friendModel_->setRows(std::move(ids));
+}
+
+void EditMemberDialog::onFilterChanged(const QString& text)
+{
+    fillFriendList(text);
+}
+
+
 EditMemberDialog::EditMemberDialog(SocialGraph& g, PersonId id, QWidget* parent)
     : QDialog(parent), graph_(g), id_(id)
 {
@@ -68,20 +88,18 @@ EditMemberDialog::EditMemberDialog(SocialGraph& g, PersonId id, QWidget* parent)
     }
 
     // 右侧：朋友勾选（把当前好友勾上）
-    friendList_ = new QListWidget;
+    friendModel_ = new FriendPickerModel(graph_, this);
+    friendList_  = new QListView;
+    friendList_->setModel(friendModel_);
     friendList_->setSelectionMode(QAbstractItemView::NoSelection);
     friendList_->setUniformItemSizes(true);
+    leFilter_ = new QLineEdit;
+    leFilter_->setPlaceholderText(u8"按姓名搜索（前缀或任意片段）");
+    leFilter_->setClearButtonEnabled(true);
 
-    const QSet<PersonId> friendsNow = graph_.friendsOf(id_);
-    for (PersonId pid : graph_.allPersons()) {
-        if (pid == id_) continue;
-        const Person* p = graph_.getPerson(pid);
-        if (!p) continue;
-        auto* it = new QListWidgetItem(p->name, friendList_);
-        it->setFlags(it->flags() | Qt::ItemIsUserCheckable);
-        it->setData(Qt::UserRole, QVariant::fromValue<qulonglong>(pid));
-        it->setCheckState(friendsNow.contains(pid) ? Qt::Checked : Qt::Unchecked);
-    }
+    for (PersonId f : graph_.friendsOf(id_)) friendModel_->setChecked(f, true);
+    fillFriendList(QString());
+    connect(leFilter_,   &QLineEdit::textChanged,   this, &EditMemberDialog::onFilterChanged);
 
     auto *btns   = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
     auto *delBtn = btns->addButton(u8"删除该成员", QDialogButtonBox::DestructiveRole);
@@ -93,6 +111,7 @@ EditMemberDialog::EditMemberDialog(SocialGraph& g, PersonId id, QWidget* parent)
     layout->addWidget(wLeft, 1);
     auto *rightBox = new QVBoxLayout;
     rightBox->addWidget(new QLabel(u8"与下列成员的好友关系（可多选）："));
+    rightBox->addWidget(leFilter_);
     rightBox->addWidget(friendList_, 1);
     auto *wRight = new QWidget; wRight->setLayout(rightBox);
     layout->addWidget(wRight, 1);
@@ -105,14 +124,7 @@ EditMemberDialog::EditMemberDialog(SocialGraph& g, PersonId id, QWidget* parent)
 
 QSet<PersonId> EditMemberDialog::selectedFriends() const
 {
-    QSet<PersonId> out;
-    for (int i=0; i<friendList_->count(); ++i) {
-        auto *it = friendList_->item(i);
-        if (it->checkState() == Qt::Checked) {
-            out.insert(static_cast<qulonglong>(it->data(Qt::UserRole).toULongLong()));
-        }
-    }
-    return out;
+    return friendModel_->checkedIds();
 }
 
 void EditMemberDialog::onAccept()
@@ -131,14 +143,8 @@ void EditMemberDialog::onAccept()
     for (int i=0;i<5;++i)
         person_.custom[i] = cbCustom_[i]->currentText().trimmed();
 
-    // 收集勾选的好友
-    selFriends_.clear();
-    for (int i=0; i<friendList_->count(); ++i) {
-        auto* it = friendList_->item(i);
-        if (it->checkState() == Qt::Checked) {
-            selFriends_.insert(static_cast<qulonglong>(it->data(Qt::UserRole).toULongLong()));
-        }
-    }
+    // 收集勾选的好友（含被过滤隐藏的）
+    selFriends_ = friendModel_->checkedIds();
 
     accept();
 }
@@ -3,8 +3,9 @@
 #include <QDialog>
 #include <QComboBox>
 #include <QLineEdit>
-#include <QListWidget>
+#include <QListView>
 #include "socialgraph.h"
+#include "friendpickermodel.h"
 
 class EditMemberDialog : public QDialog
 {
@@ -21,9 +22,11 @@ public:
 private slots:
     void onAccept();
     void onDelete();
+    void onFilterChanged(const QString& text);
 
 private:
     static void fillCombo(QComboBox* cb, const QStringList& items);
+    void fillFriendList(const QString& filter);
 
     SocialGraph& graph_;
     PersonId     id_;
@@ -33,7 +36,9 @@ private:
     QComboBox *cbPrimary_, *cbMiddle_, *cbHigh_, *cbUniv_, *cbCompany_, *cbRegion_;
     QComboBox *cbCustom_[5];                         // 新增
 
-    QListWidget* friendList_;                        // 已经有的话保留
+    QLineEdit*   leFilter_;                          // 好友列表的实时姓名过滤
+    QListView*         friendList_;
+    FriendPickerModel* friendModel_;                 // 勾选状态存在模型里，过滤换页时不丢
     QSet<PersonId> selFriends_;                      // 保存界面选择的朋友
     bool deleted_ = false;
 };
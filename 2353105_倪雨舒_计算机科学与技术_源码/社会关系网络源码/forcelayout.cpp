@@ -0,0 +1,312 @@
+#include "forcelayout.h"
+#include <QMetaObject>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Vec2 { double x = 0, y = 0; };
+
+// Barnes–Hut 四叉树：扁平数组存格子，质心在插入时增量累计
+class QuadTree
+{
+public:
+    static constexpr int    kMaxDepth = 32;        // 重合点不再细分，只累加质量
+    static constexpr double kTheta    = 0.7;       // 格子边长/距离 < θ 时整体近似（θ<√½，保证自身不被当成远处）
+
+    void build(const std::vector<Vec2>& pts)
+    {
+        pts_ = &pts;
+        cells_.clear();
+        if (pts.empty()) return;
+
+        double x0 = pts[0].x, y0 = pts[0].y, x1 = x0, y1 = y0;
+        for (const Vec2& p : pts) {
+            x0 = std::min(x0, p.x); x1 = std::max(x1, p.x);
+            y0 = std::min(y0, p.y); y1 = std::max(y1, p.y);
+        }
+        Cell root;
+        root.x0 = x0; root.y0 = y0;
+        root.size = std::max({ x1 - x0, y1 - y0, 1.0 }) * 1.0001;
+        cells_.reserve(pts.size() * 2);
+        cells_.push_back(root);
+        for (int i = 0; i < int(pts.size()); ++i) insert(i);
+    }
+
+    // 第 i 个点受到的全部斥力（k²·m/d）
+    Vec2 repulsion(int i, double k2) const
+    {
+        Vec2 f;
+        if (cells_.empty()) return f;
+        const Vec2 p = (*pts_)[size_t(i)];
+        int stack[4 * kMaxDepth + 8];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Cell& c = cells_[size_t(stack[--top])];
+            if (c.mass <= 0) continue;
+            double dx = p.x - c.cx, dy = p.y - c.cy;
+            double d2 = dx * dx + dy * dy;
+            double m  = c.mass;
+
+            if (!c.isLeaf() && c.size * c.size >= kTheta * kTheta * d2) {
+                for (int ch : c.child) if (ch >= 0) stack[top++] = ch;
+                continue;
+            }
+            if (c.isLeaf() && c.body == i) {       // 自己所在的叶子：去掉自身质量
+                m -= 1;
+                if (m <= 0) continue;
+            }
+            if (d2 < 1e-4) {                       // 完全重合：按序号给个确定的小扰动
+                dx = 0.01 * ((i % 7) - 3 + 0.5);
+                dy = 0.01 * ((i % 5) - 2 + 0.5);
+                d2 = dx * dx + dy * dy;
+            }
+            const double s = k2 * m / d2;          // (k²m/d) · (1/d) 单位化
+            f.x += dx * s;
+            f.y += dy * s;
+        }
+        return f;
+    }
+
+private:
+    struct Cell {
+        double cx = 0, cy = 0, mass = 0;
+        double x0 = 0, y0 = 0, size = 0;
+        int    child[4] = { -1, -1, -1, -1 };
+        int    body = -1;                          // 叶子上的点；-1 表示内部格子或空
+        bool   isLeaf() const { return child[0] < 0 && child[1] < 0 && child[2] < 0 && child[3] < 0; }
+    };
+
+    int quadrant(const Cell& c, const Vec2& p) const
+    {
+        const double h = c.size / 2;
+        return (p.x >= c.x0 + h ? 1 : 0) | (p.y >= c.y0 + h ? 2 : 0);
+    }
+
+    int ensureChild(int ci, int q)
+    {
+        if (cells_[size_t(ci)].child[q] >= 0) return cells_[size_t(ci)].child[q];
+        const Cell& c = cells_[size_t(ci)];
+        Cell n;
+        n.size = c.size / 2;
+        n.x0 = c.x0 + ((q & 1) ? n.size : 0);
+        n.y0 = c.y0 + ((q & 2) ? n.size : 0);
+        const int idx = int(cells_.size());
+        cells_.push_back(n);                       // 之后 c 可能失效，只用下标
+        cells_[size_t(ci)].child[q] = idx;
+        return idx;
+    }
+
+    void insert(int b)
+    {
+        const Vec2 p = (*pts_)[size_t(b)];
+        int ci = 0;
+        for (int depth = 0; ; ++depth) {
+            Cell& c = cells_[size_t(ci)];
+            const double m = c.mass;
+            c.cx = (c.cx * m + p.x) / (m + 1);
+            c.cy = (c.cy * m + p.y) / (m + 1);
+            c.mass = m + 1;
+            if (m == 0) { c.body = b; return; }
+            if (depth >= kMaxDepth) return;
+
+            if (c.body >= 0) {                     // 叶子分裂：原来的点下放一层
+                const int old = c.body;
+                c.body = -1;
+                const Vec2 op = (*pts_)[size_t(old)];
+                const int ch = ensureChild(ci, quadrant(cells_[size_t(ci)], op));
+                Cell& cc = cells_[size_t(ch)];
+                cc.cx = op.x; cc.cy = op.y; cc.mass = 1; cc.body = old;
+            }
+            ci = ensureChild(ci, quadrant(cells_[size_t(ci)], p));
+        }
+    }
+
+    const std::vector<Vec2>* pts_ = nullptr;
+    std::vector<Cell>        cells_;
+};
+
+// 一轮 FR 迭代：斥力（四叉树）+ 沿边引力 + 指向重心的弱引力（防止孤立分量飘走），
+// 位移长度不超过温度 t；pinned 的点不动
+void layoutStep(std::vector<Vec2>& pos, std::vector<Vec2>& disp,
+                const std::vector<std::pair<int, int>>& edges,
+                const std::vector<char>& pinned, QuadTree& tree, double k, double t)
+{
+    const int n = int(pos.size());
+    if (n == 0) return;
+    const double k2 = k * k;
+
+    tree.build(pos);
+    Vec2 center;
+    for (const Vec2& p : pos) { center.x += p.x; center.y += p.y; }
+    center.x /= n; center.y /= n;
+
+    for (int i = 0; i < n; ++i) disp[size_t(i)] = tree.repulsion(i, k2);
+
+    for (const auto& e : edges) {
+        Vec2& pa = pos[size_t(e.first)];
+        Vec2& pb = pos[size_t(e.second)];
+        const double dx = pa.x - pb.x, dy = pa.y - pb.y;
+        const double d  = std::sqrt(dx * dx + dy * dy);
+        if (d < 1e-9) continue;
+        const double s = d / k;                     // (d²/k) · (1/d)
+        disp[size_t(e.first)].x  -= dx * s;  disp[size_t(e.first)].y  -= dy * s;
+        disp[size_t(e.second)].x += dx * s;  disp[size_t(e.second)].y += dy * s;
+    }
+
+    const double gravity = 0.5 / std::sqrt(double(n));
+    for (int i = 0; i < n; ++i) {
+        if (pinned[size_t(i)]) continue;
+        Vec2& d = disp[size_t(i)];
+        d.x -= (pos[size_t(i)].x - center.x) * gravity;
+        d.y -= (pos[size_t(i)].y - center.y) * gravity;
+        const double len = std::sqrt(d.x * d.x + d.y * d.y);
+        if (len < 1e-9) continue;
+        const double step = std::min(len, t) / len;
+        pos[size_t(i)].x += d.x * step;
+        pos[size_t(i)].y += d.y * step;
+    }
+}
+
+} // namespace
+
+ForceLayout::ForceLayout(QObject* parent) : QObject(parent) {}
+
+ForceLayout::~ForceLayout()
+{
+    stop();
+}
+
+void ForceLayout::start(const QVector<PersonId>& ids, const QVector<QPointF>& pos,
+                        const QVector<QPair<int, int>>& edges, int iterations)
+{
+    stop();
+
+    ids_ = ids;
+    index_.clear();
+    index_.reserve(ids.size());
+    for (int i = 0; i < ids.size(); ++i) index_.insert(ids[i], i);
+
+    edges_.clear();
+    edges_.reserve(size_t(edges.size()));
+    for (const auto& e : edges) edges_.emplace_back(e.first, e.second);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame_ = pos;
+        frameFresh_ = false;
+        pins_.clear();
+        pinsDirty_ = true;
+    }
+
+    stop_ = false;
+    paused_ = false;
+    running_ = true;
+    const quint64 gen = ++generation_;
+    worker_ = std::thread([this, iterations, gen]{ run(iterations, gen); });
+}
+
+// 标志在 mutex_ 下修改：工作线程在锁内检查等待条件，否则通知可能落在“检查完、还没睡下”之间而丢失
+void ForceLayout::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        paused_ = false;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) worker_.join();
+    running_ = false;
+}
+
+void ForceLayout::pause()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    paused_ = true;
+}
+
+void ForceLayout::resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = false;
+    }
+    wake_.notify_all();
+}
+
+void ForceLayout::pin(PersonId id, const QPointF& p)
+{
+    const int i = index_.value(id, -1);
+    if (i < 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    pins_.insert(i, p);
+    pinsDirty_ = true;
+}
+
+void ForceLayout::unpin(PersonId id)
+{
+    const int i = index_.value(id, -1);
+    if (i < 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    pins_.remove(i);
+    pinsDirty_ = true;
+}
+
+bool ForceLayout::takeFrame(QVector<QPointF>& out)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!frameFresh_) return false;
+    out = frame_;
+    frameFresh_ = false;
+    return true;
+}
+
+void ForceLayout::run(int iterations, quint64 generation)
+{
+    // 迭代用工作线程自己的 std 容器，只有每轮结束写 frame_ 时才加锁
+    std::vector<Vec2> pos, disp;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pos.resize(size_t(frame_.size()));
+        for (int i = 0; i < frame_.size(); ++i) pos[size_t(i)] = { frame_[i].x(), frame_[i].y() };
+    }
+    disp.resize(pos.size());
+    std::vector<char> pinned(pos.size(), 0);
+    std::vector<std::pair<int, Vec2>> pinPos;
+
+    const double t0 = k_ * std::max(2.0, std::sqrt(double(pos.size())) * 0.5);
+    QuadTree tree;
+
+    for (int it = 0; it < iterations && !stop_; ++it) {
+        if (paused_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]{ return !paused_ || stop_; });
+            if (stop_) break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pinsDirty_) {
+                std::fill(pinned.begin(), pinned.end(), 0);
+                pinPos.clear();
+                for (auto p = pins_.cbegin(); p != pins_.cend(); ++p) {
+                    if (p.key() < 0 || size_t(p.key()) >= pinned.size()) continue;
+                    pinned[size_t(p.key())] = 1;
+                    pinPos.push_back({ p.key(), Vec2{ p.value().x(), p.value().y() } });
+                }
+                pinsDirty_ = false;
+            }
+        }
+        for (const auto& p : pinPos) pos[size_t(p.first)] = p.second;
+
+        const double t = t0 * (1.0 - double(it) / iterations) + 1.0;   // 线性冷却
+        layoutStep(pos, disp, edges_, pinned, tree, k_, t);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < pos.size(); ++i) frame_[int(i)] = QPointF(pos[i].x, pos[i].y);
+        frameFresh_ = true;
+    }
+
+    running_ = false;
+    if (!stop_) QMetaObject::invokeMethod(this, [this, generation]{ emit finished(generation); }, Qt::QueuedConnection);
+}
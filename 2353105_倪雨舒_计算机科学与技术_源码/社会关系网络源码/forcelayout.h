@@ -0,0 +1,72 @@
+// forcelayout.h
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QPair>
+#include <QHash>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using PersonId = quint64;
+
+/**
+ * 力导向布局（Fruchterman–Reingold + Barnes–Hut 四叉树近似）：
+ * - 斥力 k²/d 作用于所有点对，用四叉树把远处的一团点当成一个质点，每轮 O(n log n)；
+ * - 引力 d²/k 只沿好友边；位移受“温度”限制，温度逐轮冷却。
+ * 在后台线程迭代；界面按帧调用 takeFrame() 取最近一轮的坐标（有新结果才拷贝）。
+ * 被用户拖住的点用 pin() 固定在给定位置，参与受力但自身不动；松手后 unpin() 交还给布局。
+ * 自然收敛时发出 finished(generation)，坐标由调用方写回 SocialGraph；
+ * 每次 start() 换一个代号，排队中的旧一轮 finished 可按 generation() 认出并丢弃。
+ */
+class ForceLayout : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ForceLayout(QObject* parent = nullptr);
+    ~ForceLayout() override;
+
+    // edges 为下标对（指向 ids/pos）；再次 start 会先停掉上一轮
+    void start(const QVector<PersonId>& ids, const QVector<QPointF>& pos,
+               const QVector<QPair<int, int>>& edges, int iterations = 300);
+    void stop();                       // 停止并等待线程退出
+    void pause();
+    void resume();
+    bool isRunning() const { return running_.load(); }
+    bool isPaused()  const { return paused_.load(); }
+    quint64 generation() const { return generation_; }   // 当前（最近一次 start 的）一轮
+
+    void pin(PersonId id, const QPointF& p);
+    void unpin(PersonId id);
+
+    bool takeFrame(QVector<QPointF>& out);            // 有新一轮结果时拷出并返回 true
+    const QVector<PersonId>& ids() const { return ids_; }
+
+signals:
+    void finished(quint64 generation);                // 在所属线程（GUI）里发出
+
+private:
+    void run(int iterations, quint64 generation);
+
+    QVector<PersonId>         ids_;
+    QHash<PersonId, int>      index_;
+    std::vector<std::pair<int, int>> edges_;          // start() 里填好，之后只有工作线程读
+    double                    k_ = 120.0;             // 理想边长
+    quint64                   generation_ = 0;        // 只在 GUI 线程读写
+
+    std::thread               worker_;
+    std::atomic<bool>         running_{false};
+    std::atomic<bool>         paused_{false};
+    std::atomic<bool>         stop_{false};
+    std::mutex                mutex_;                 // 保护下面几项
+    std::condition_variable   wake_;
+    QVector<QPointF>          frame_;
+    bool                      frameFresh_ = false;
+    QHash<int, QPointF>       pins_;
+    bool                      pinsDirty_ = false;
+};
@@ -0,0 +1,77 @@
+#include "friendpickermodel.h"
+
+FriendPickerModel::FriendPickerModel(const SocialGraph& g, QObject* parent)
+    : QAbstractListModel(parent), graph_(g), bits_(g.personCount())
+{
+}
+
+void FriendPickerModel::showAll(PersonId exclude)
+{
+    beginResetModel();
+    all_ = true;
+    skipRow_ = exclude ? graph_.personRow(exclude) : -1;
+    rows_.clear();
+    endResetModel();
+}
+
+void FriendPickerModel::setRows(QVector<PersonId> rows)
+{
+    beginResetModel();
+    all_ = false;
+    rows_ = std::move(rows);
+    endResetModel();
+}
+
+void FriendPickerModel::setChecked(PersonId id, bool on)
+{
+    const int r = graph_.personRow(id);
+    if (r < 0 || r >= bits_.size()) return;
+    bits_.setBit(r, on);
+    if (on) checked_.insert(id);
+    else    checked_.remove(id);
+}
+
+PersonId FriendPickerModel::idAt(int row) const
+{
+    if (!all_) return rows_[row];
+    return graph_.personAt(graphRow(row));
+}
+
+int FriendPickerModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    if (!all_) return int(rows_.size());
+    return graph_.personCount() - (skipRow_ >= 0 ? 1 : 0);
+}
+
+QVariant FriendPickerModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) return {};
+    const PersonId id = idAt(index.row());
+    switch (role) {
+    case Qt::DisplayRole: {
+        const Person* p = graph_.getPerson(id);
+        return p ? p->name : QString();
+    }
+    case Qt::CheckStateRole: {
+        const bool on = all_ ? testRow(graphRow(index.row())) : isChecked(id);   // 未过滤时行号即位号
+        return on ? Qt::Checked : Qt::Unchecked;
+    }
+    case Qt::UserRole:       return QVariant::fromValue<qulonglong>(id);
+    default:                 return {};
+    }
+}
+
+bool FriendPickerModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (role != Qt::CheckStateRole || !index.isValid() || index.row() >= rowCount()) return false;
+    setChecked(idAt(index.row()), value.toInt() == Qt::Checked);
+    emit dataChanged(index, index, { Qt::CheckStateRole });
+    return true;
+}
+
+Qt::ItemFlags FriendPickerModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsUserCheckable;
+}
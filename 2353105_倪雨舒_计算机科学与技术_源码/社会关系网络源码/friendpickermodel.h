@@ -0,0 +1,47 @@
+// friendpickermodel.h
+#pragma once
+
+#include <QAbstractListModel>
+#include <QBitArray>
+#include <QVector>
+#include <QSet>
+#include "socialgraph.h"
+
+/**
+ * 好友勾选列表的数据模型（配合 QListView 使用）：
+ * - 未过滤时不复制成员表：行数即成员数，第 row 行在 data() 里经 SocialGraph::personAt() 取 id，
+ *   打开对话框的开销与成员总数无关；过滤时只存索引给出的那一批 id；
+ * - 姓名在 data() 里按需从图中取，视图只为可见行取数据；
+ * - 勾选状态放在按成员行号（SocialGraph::personRow）下标的位图里，n 个成员只占 n 位，
+ *   未过滤时第 row 行直接对应一位；另记一份已勾选集合，取结果只花 O(勾选数)。
+ *   对话框是模态的，打开期间成员表不变，行号稳定；过滤切换时勾选不丢。
+ */
+class FriendPickerModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit FriendPickerModel(const SocialGraph& g, QObject* parent = nullptr);
+
+    void showAll(PersonId exclude = 0);            // 列出全部成员（按 id 升序），exclude 不列
+    void setRows(QVector<PersonId> rows);          // 换成一批过滤结果
+    void setChecked(PersonId id, bool on);
+    bool isChecked(PersonId id) const { return testRow(graph_.personRow(id)); }
+    QSet<PersonId> checkedIds() const { return checked_; }
+
+    int           rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant      data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool          setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    int      graphRow(int row) const { return skipRow_ >= 0 && row >= skipRow_ ? row + 1 : row; }   // all_ 时
+    PersonId idAt(int row) const;
+    bool     testRow(int r) const { return r >= 0 && r < bits_.size() && bits_.testBit(r); }
+
+    const SocialGraph& graph_;
+    bool               all_ = false;               // true：行直接映射到图的成员序号
+    int                skipRow_ = -1;              // all_ 时跳过的序号（编辑对话框里的本人）
+    QVector<PersonId>  rows_;                      // 过滤结果
+    QBitArray          bits_;                      // 成员行号 -> 是否勾选
+    QSet<PersonId>     checked_;                   // 与 bits_ 同步，只为 checkedIds()
+};
@@ -1,11 +1,251 @@
 #include "mainwindow.h"
+#include "socialgraph.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QLocale>
+#include <QTextStream>
 #include <QTranslator>
+#include <cerrno>
+#include <cstring>
+#ifdef Q_OS_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 命令行（无界面）：SocialNetworks --memory-report [--compact] [social_network.json]
+//   --compact：先把邻接表转为压缩形式再统计，便于对比两种存储的占用
+//   SocialNetworks --order-report [social_network.json]
+//   对比三种内部存储顺序：编码字节数、好友序号平均间距、二跳遍历耗时与缓存未命中次数
+//   （Linux 上经 perf_event_open 只数二跳遍历这一段；没有硬件计数器的环境显示 n/a）。
+//   SocialNetworks --bench-edit [人数]
+//   合成一张图（默认 20000 人、每人约 8 个好友），模拟界面“每次编辑后取快照”的节奏，
+//   统计发布快照之后单次编辑（改资料 / 加好友 / 删好友）的平均与最长耗时。
+static int runMemoryReport(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QString path = QDir(QCoreApplication::applicationDirPath()).filePath("social_network.json");
+    bool compact = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--compact") == 0)            compact = true;
+        else if (std::strcmp(argv[i], "--memory-report") != 0) path = QString::fromLocal8Bit(argv[i]);
+    }
+
+    QTextStream out(stdout);
+    SocialGraph g;
+    if (!g.loadFromFile(path)) {
+        out << "cannot load " << path << Qt::endl;
+        return 1;
+    }
+    if (compact) g.compactAdjacency();
+    out << g.memoryReport().toText();
+    return 0;
+}
+
+// 硬件缓存未命中计数：perf_event_open(PERF_COUNT_HW_CACHE_MISSES)，只数本线程用户态；
+// 非 Linux、权限不足或虚拟机没有暴露 PMU 时 available() 为 false，error() 给出原因
+class CacheMissCounter
+{
+public:
+    CacheMissCounter()
+    {
+#ifdef Q_OS_LINUX
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size           = sizeof attr;
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd_ = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ < 0) {
+            const int err = errno;
+            error_ = err == ENOENT || err == ENODEV || err == EOPNOTSUPP
+                   ? QStringLiteral("no hardware cache counter")      // 常见于没有 PMU 的虚拟机
+                   : QString::fromLocal8Bit(std::strerror(err));
+        }
+#else
+        error_ = QStringLiteral("not Linux");
+#endif
+    }
+    ~CacheMissCounter()
+    {
+#ifdef Q_OS_LINUX
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool    available() const { return fd_ >= 0; }
+    QString error() const     { return error_; }
+
+    void start()
+    {
+#ifdef Q_OS_LINUX
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    qint64 stop()                                    // 自 start() 以来的次数；不可用时 -1
+    {
+#ifdef Q_OS_LINUX
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        quint64 n = 0;
+        return read(fd_, &n, sizeof n) == ssize_t(sizeof n) ? qint64(n) : -1;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int     fd_ = -1;
+    QString error_;
+};
+
+// 二跳遍历：按存储顺序走每个人的每个好友的好友表，访存模式与推荐计算相同
+static quint64 sweepTwoHop(const CompressedAdjacency& c)
+{
+    quint64 acc = 0;
+    for (quint32 u = 0; u < quint32(c.vertexCount()); ++u) {
+        CompressedAdjacency::Cursor cu = c.cursorAt(u);
+        for (quint32 v; cu.next(v); ) {
+            CompressedAdjacency::Cursor cv = c.cursorAt(v);
+            for (quint32 w; cv.next(w); ) acc += w;
+        }
+    }
+    return acc;
+}
+
+static int runOrderReport(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QString path = QDir(QCoreApplication::applicationDirPath()).filePath("social_network.json");
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--order-report") != 0) path = QString::fromLocal8Bit(argv[i]);
+    }
+
+    QTextStream out(stdout);
+    SocialGraph g;
+    if (!g.loadFromFile(path)) {
+        out << "cannot load " << path << Qt::endl;
+        return 1;
+    }
+
+    QHash<PersonId, QSet<PersonId>> adj;
+    for (PersonId id : g.allPersons()) adj.insert(id, {});
+    for (const auto& e : g.allFriendEdges()) {
+        adj[e.first].insert(e.second);
+        adj[e.second].insert(e.first);
+    }
+
+    using Order = CompressedAdjacency::VertexOrder;
+    const struct { Order order; const char* name; } orders[] = {
+        { Order::ById,                "by-id" },
+        { Order::DegreeSorted,        "degree" },
+        { Order::ReverseCuthillMcKee, "rcm" },
+    };
+    out << "persons " << adj.size() << ", edges " << g.allFriendEdges().size() << Qt::endl;
+    CacheMissCounter misses;
+    if (misses.available()) out << "cache misses: hardware counter, user space, per 2-hop sweep" << Qt::endl;
+    else                    out << "cache misses: n/a (" << misses.error() << "), compare by gap and time" << Qt::endl;
+    for (const auto& o : orders) {
+        QElapsedTimer t;
+        t.start();
+        const CompressedAdjacency c = CompressedAdjacency::build(adj, o.order);
+        const qint64 buildMs = t.elapsed();
+
+        const int rounds = 5;
+        quint64 check = 0;
+        t.restart();
+        misses.start();
+        for (int r = 0; r < rounds; ++r) check += sweepTwoHop(c);
+        const qint64 missCount = misses.stop();
+        const double sweepMs = double(t.nsecsElapsed()) / 1e6 / rounds;
+
+        out << qSetFieldWidth(8) << Qt::left << o.name << qSetFieldWidth(0)
+            << " bytes " << c.arrayBytes()
+            << "  gap " << QString::number(c.meanNeighborGap(), 'f', 1)
+            << "  build " << buildMs << " ms"
+            << "  2-hop " << QString::number(sweepMs, 'f', 2) << " ms"
+            << "  misses " << (missCount < 0 ? QStringLiteral("n/a") : QString::number(missCount / rounds))
+            << "  (" << (check & 0xFFFF) << ")" << Qt::endl;
+    }
+    return 0;
+}
+
+static int runEditBench(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    int n = 20000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-edit") != 0) n = qMax(2, QByteArray(argv[i]).toInt());
+    }
+
+    SocialGraph g;
+    g.reserve(n);
+    QVector<PersonId> ids;
+    ids.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        Person p;
+        p.name = QStringLiteral("成员%1").arg(i);
+        ids.push_back(g.addPerson(p));
+    }
+    quint32 seed = 12345;
+    auto rnd = [&seed](int m){ seed = seed * 1664525u + 1013904223u; return int((seed >> 8) % quint32(m)); };
+    for (int i = 0; i < n * 4; ++i) g.addFriendship(ids[rnd(n)], ids[rnd(n)]);
+
+    QTextStream out(stdout);
+    out << "persons " << g.personCount() << ", edges " << g.allFriendEdges().size() << Qt::endl;
+
+    const int rounds = 500;
+    const struct { const char* name; int kind; } kinds[] = { { "update", 0 }, { "befriend", 1 }, { "unfriend", 2 } };
+    for (const auto& k : kinds) {
+        qint64 total = 0, worst = 0;
+        for (int r = 0; r < rounds; ++r) {
+            const PersonId a = ids[rnd(n)], b = ids[rnd(n)];
+            if (k.kind == 2) g.addFriendship(a, b);
+            const SocialGraph::SnapshotPtr snap = g.snapshot();   // 界面每次编辑后都会发布
+            QElapsedTimer t;
+            t.start();
+            if (k.kind == 0) {
+                Person p = *g.getPerson(a);
+                p.company = QStringLiteral("公司%1").arg(r);
+                g.updatePerson(p);
+            } else if (k.kind == 1) {
+                g.addFriendship(a, b);
+            } else {
+                g.removeFriendship(a, b);
+            }
+            const qint64 ns = t.nsecsElapsed();
+            total += ns;
+            worst = qMax(worst, ns);
+        }
+        out << qSetFieldWidth(9) << Qt::left << k.name << qSetFieldWidth(0)
+            << " avg " << QString::number(double(total) / rounds / 1e3, 'f', 1) << " us"
+            << "  max " << QString::number(double(worst) / 1e3, 'f', 1) << " us" << Qt::endl;
+    }
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--memory-report") == 0)
+            return runMemoryReport(argc, argv);
+        if (std::strcmp(argv[i], "--order-report") == 0)
+            return runOrderReport(argc, argv);
+        if (std::strcmp(argv[i], "--bench-edit") == 0)
+            return runEditBench(argc, argv);
+    }
+
     QApplication a(argc, argv);
     a.setStyleSheet(R"(
         QPushButton {
@@ -0,0 +1,203 @@
+#include "nameindex.h"
+#include <algorithm>
+
+QVector<quint32> NameIndex::gramsOf(const QString& folded)
+{
+    QVector<quint32> out;
+    if (folded.size() < 2) return out;
+    out.reserve(folded.size() - 1);
+    for (qsizetype i = 0; i + 1 < folded.size(); ++i)
+        out.push_back(gram(folded.at(i).unicode(), folded.at(i + 1).unicode()));
+    return out;
+}
+
+int NameIndex::child(int node, char16_t c) const
+{
+    const auto& kids = nodes_[node].kids;
+    auto it = std::lower_bound(kids.cbegin(), kids.cend(), c,
+                               [](const QPair<char16_t, int>& k, char16_t v){ return k.first < v; });
+    return (it != kids.cend() && it->first == c) ? it->second : -1;
+}
+
+int NameIndex::ensureChild(int node, char16_t c)
+{
+    const int found = child(node, c);
+    if (found >= 0) return found;
+
+    int created;
+    if (!free_.isEmpty()) {
+        created = free_.takeLast();          // 回收时已清空
+    } else {
+        created = int(nodes_.size());
+        nodes_.push_back(Node{});
+    }
+    auto& kids = nodes_[node].kids;          // push_back 之后再取引用
+    auto it = std::lower_bound(kids.begin(), kids.end(), c,
+                               [](const QPair<char16_t, int>& k, char16_t v){ return k.first < v; });
+    kids.insert(it, qMakePair(c, created));
+    return created;
+}
+
+int NameIndex::findNode(const QString& folded) const
+{
+    int n = 0;
+    for (QChar ch : folded) {
+        n = child(n, ch.unicode());
+        if (n < 0) return -1;
+    }
+    return n;
+}
+
+void NameIndex::insert(PersonId id, const QString& name)
+{
+    if (names_.contains(id)) remove(id);
+    const QString f = fold(name);
+    names_.insert(id, f);
+
+    int n = 0;
+    ++nodes_[0].count;
+    for (QChar ch : f) {
+        n = ensureChild(n, ch.unicode());
+        ++nodes_[n].count;
+    }
+    nodes_[n].ids.push_back(id);
+
+    for (quint32 g : gramsOf(f)) grams_[g].insert(id);
+}
+
+void NameIndex::remove(PersonId id)
+{
+    auto it = names_.find(id);
+    if (it == names_.end()) return;
+    const QString f = it.value();
+    names_.erase(it);
+
+    // 计数是子树内人数：路径上第一个降到 0 的节点以下全空，整枝回收
+    int n = 0, cut = -1, cutParent = 0;
+    char16_t cutChar = 0;
+    --nodes_[0].count;
+    for (QChar ch : f) {
+        const int parent = n;
+        n = child(n, ch.unicode());
+        if (--nodes_[n].count == 0 && cut < 0) {
+            cut = n;
+            cutParent = parent;
+            cutChar = ch.unicode();
+        }
+    }
+    nodes_[n].ids.removeOne(id);
+    if (cut >= 0) release(cutParent, cutChar, cut);
+
+    for (quint32 g : gramsOf(f)) {
+        auto gi = grams_.find(g);
+        if (gi == grams_.end()) continue;
+        gi->remove(id);
+        if (gi->isEmpty()) grams_.erase(gi);
+    }
+}
+
+void NameIndex::release(int parent, char16_t c, int node)
+{
+    auto& kids = nodes_[parent].kids;
+    auto it = std::lower_bound(kids.begin(), kids.end(), c,
+                               [](const QPair<char16_t, int>& k, char16_t v){ return k.first < v; });
+    if (it != kids.end() && it->first == c) kids.erase(it);
+
+    QVector<int> stack { node };
+    while (!stack.isEmpty()) {
+        const int n = stack.takeLast();
+        for (const auto& k : nodes_[n].kids) stack.push_back(k.second);
+        nodes_[n] = Node{};
+        free_.push_back(n);
+    }
+}
+
+void NameIndex::clear()
+{
+    nodes_ = { Node{} };
+    free_.clear();
+    names_.clear();
+    grams_.clear();
+}
+
+void NameIndex::reserve(int count)
+{
+    names_.reserve(count);
+}
+
+// 从前缀所在节点按层遍历：层数即名字长度，天然“短的在前”
+QVector<PersonId> NameIndex::prefixSearch(const QString& prefix, int limit) const
+{
+    QVector<PersonId> out;
+    const int start = findNode(fold(prefix));
+    if (start < 0 || limit <= 0) return out;
+
+    QVector<int> level { start }, next;
+    while (!level.isEmpty() && out.size() < limit) {
+        next.clear();
+        for (int n : level) {
+            const Node& node = nodes_[n];
+            if (node.count == 0) continue;
+            QVector<PersonId> ids = node.ids;
+            std::sort(ids.begin(), ids.end());
+            for (PersonId id : ids) {
+                out.push_back(id);
+                if (out.size() >= limit) return out;
+            }
+            for (const auto& k : node.kids) next.push_back(k.second);
+        }
+        level.swap(next);
+    }
+    return out;
+}
+
+QVector<PersonId> NameIndex::search(const QString& query, int limit) const
+{
+    const QString q = fold(query);
+    if (q.isEmpty() || limit <= 0) return {};
+
+    QVector<PersonId> out = prefixSearch(q, limit);
+    if (out.size() >= limit || q.size() < 2) return out;   // 单字只查前缀，见类注释
+
+    // 子串：取最短的一条二元组倒排作候选，逐个核对
+    const QSet<PersonId>* best = nullptr;
+    for (quint32 g : gramsOf(q)) {
+        auto it = grams_.constFind(g);
+        if (it == grams_.cend()) return out;
+        if (!best || it->size() < best->size()) best = &it.value();
+    }
+    if (!best) return out;
+
+    const QSet<PersonId> already(out.cbegin(), out.cend());
+    struct Hit { qsizetype pos; qsizetype len; PersonId id; };
+    QVector<Hit> hits;
+    for (PersonId id : *best) {
+        if (already.contains(id)) continue;
+        const QString name = names_.value(id);
+        const qsizetype pos = name.indexOf(q);
+        if (pos > 0) hits.push_back({ pos, name.size(), id });
+    }
+
+    const qsizetype take = std::min<qsizetype>(hits.size(), limit - out.size());
+    auto byRank = [](const Hit& a, const Hit& b){
+        if (a.pos != b.pos) return a.pos < b.pos;
+        if (a.len != b.len) return a.len < b.len;
+        return a.id < b.id;
+    };
+    std::partial_sort(hits.begin(), hits.begin() + take, hits.end(), byRank);
+    for (qsizetype i = 0; i < take; ++i) out.push_back(hits[i].id);
+    return out;
+}
+
+// 粗略估算：节点数组 + 孩子表 + 名字副本 + 倒排条目（按每条 ~16 字节计）
+qint64 NameIndex::approxBytes() const
+{
+    qint64 bytes = qint64(nodes_.capacity()) * qint64(sizeof(Node))
+                 + qint64(free_.capacity()) * qint64(sizeof(int));
+    for (const Node& n : nodes_)
+        bytes += qint64(n.kids.capacity()) * qint64(sizeof(QPair<char16_t, int>))
+               + qint64(n.ids.capacity())  * qint64(sizeof(PersonId));
+    for (const QString& s : names_) bytes += 32 + s.size() * 2;
+    for (const auto& s : grams_)    bytes += 32 + qint64(s.size()) * 16;
+    return bytes;
+}
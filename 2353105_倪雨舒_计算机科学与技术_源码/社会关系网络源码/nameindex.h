@@ -0,0 +1,56 @@
+// nameindex.h
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+using PersonId = quint64;
+
+/**
+ * 姓名搜索索引（增量维护，供好友勾选框实时过滤）：
+ * - 前缀树：按折叠大小写后的 UTF-16 字符逐层建树，终点挂人员 id；
+ *   每个节点记录子树内人数；删除后计数降为 0 的整条分支从父节点摘下，
+ *   节点进空闲表供之后插入复用，改名/删人多了节点数也不会无限增长。
+ * - n-gram 倒排：每个名字的相邻两字各建一条倒排（中文姓名通常 2~4 字，
+ *   三元组太长），子串查询先取查询串各二元组倒排中最短的一条，再逐个校验。
+ *   单字查询只走前缀：常用字的单字倒排会覆盖大半成员，逐个校验就是 O(n)，不建也不查。
+ * 排序：完全相同 > 前缀命中（名字越短越靠前）> 子串命中（出现位置越靠前、名字越短越靠前）。
+ */
+class NameIndex
+{
+public:
+    void insert(PersonId id, const QString& name);
+    void remove(PersonId id);
+    void clear();
+    void reserve(int count);
+
+    QVector<PersonId> prefixSearch(const QString& prefix, int limit) const;
+    QVector<PersonId> search(const QString& query, int limit) const;   // 前缀 + 子串，已排序
+
+    int    size() const { return names_.size(); }
+    qint64 approxBytes() const;
+
+private:
+    struct Node {
+        QVector<QPair<char16_t, int>> kids;   // 按字符升序，二分查找
+        QVector<PersonId>             ids;    // 名字恰好到此结束的人
+        int                           count = 0;
+    };
+
+    static QString fold(const QString& name) { return name.trimmed().toCaseFolded(); }
+    static quint32 gram(char16_t a, char16_t b) { return (quint32(a) << 16) | b; }
+    static QVector<quint32> gramsOf(const QString& folded);
+
+    int  child(int node, char16_t c) const;
+    int  ensureChild(int node, char16_t c);
+    int  findNode(const QString& folded) const;
+    void release(int parent, char16_t c, int node);   // 摘下并回收 node 整棵子树
+
+    QVector<Node>                   nodes_ { Node{} };   // 0 号为根
+    QVector<int>                    free_;               // 已回收、可复用的节点下标
+    QHash<PersonId, QString>        names_;              // id -> 折叠后的名字
+    QHash<quint32, QSet<PersonId>>  grams_;
+};
@@ -0,0 +1,72 @@
+#include "networkscene.h"
+#include "nodeitem.h"
+#include "spatialgrid.h"
+#include <QHash>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+#include <cmath>
+
+// 把 area 内的点按 cell 分格；area 已按 cell 对齐，落在里面的格子人数完整
+void NetworkScene::rebuildBins(const QRectF& area, qreal cell)
+{
+    bins_.clear();
+    binArea_    = area;
+    binCell_    = cell;
+    binVersion_ = grid_->version();
+    points_.clear();
+    grid_->pointsIn(area, points_);
+    for (const QPointF& pt : points_) {
+        const int cx = qFloor(pt.x() / cell), cy = qFloor(pt.y() / cell);
+        Bin& b = bins_[(quint64(quint32(cx)) << 32) | quint32(cy)];
+        b.sx += pt.x();
+        b.sy += pt.y();
+        b.cx = cx;
+        b.cy = cy;
+        ++b.count;
+    }
+}
+
+void NetworkScene::drawForeground(QPainter* p, const QRectF& rect)
+{
+    if (!grid_) return;
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(p->worldTransform());
+    if (lod >= NodeItem::kClusterLod) return;
+
+    // 聚合格按全局对齐，重绘区向外扩两格：落在边上的格子人数完整，符号也不会被截半
+    const qreal cell = kGlyphPixels / lod;
+    const int x0 = qFloor(rect.left() / cell) - 2, y0 = qFloor(rect.top() / cell) - 2;
+    const int x1 = x0 + qCeil(rect.width() / cell) + 4, y1 = y0 + qCeil(rect.height() / cell) + 4;
+    const QRectF area(x0 * cell, y0 * cell, (x1 - x0 + 1) * cell, (y1 - y0 + 1) * cell);
+
+    // 缓存失效：坐标变了、缩放变了，或平移出了缓存范围。因平移/缩放重建时四周各多算半个重绘区；
+    // 坐标在变（布局每帧都在动）时下一帧多半又要重建，只算重绘区本身
+    const bool moved = binVersion_ != grid_->version();
+    if (moved || binCell_ != cell || !binArea_.contains(area)) {
+        const int padX = moved ? 0 : (x1 - x0) / 2 + 1, padY = moved ? 0 : (y1 - y0) / 2 + 1;
+        rebuildBins(QRectF((x0 - padX) * cell, (y0 - padY) * cell,
+                           (x1 - x0 + 1 + 2 * padX) * cell, (y1 - y0 + 1 + 2 * padY) * cell), cell);
+    }
+    if (bins_.isEmpty()) return;
+
+    p->save();
+    p->setRenderHint(QPainter::Antialiasing, true);
+    QFont f = p->font();
+    f.setBold(true);
+    f.setPixelSize(qMax(1, qRound(11 / lod)));   // 场景单位，经缩放后约 11 像素
+    p->setFont(f);
+    const QColor fill(135, 206, 250, 200);        // 与普通成员同色
+    for (const Bin& b : bins_) {
+        if (b.cx < x0 || b.cx > x1 || b.cy < y0 || b.cy > y1) continue;
+        const QPointF c(b.sx / b.count, b.sy / b.count);
+        const qreal r = (4 + 3 * std::log2(qreal(b.count))) / lod;
+        p->setPen(Qt::NoPen);
+        p->setBrush(fill);
+        p->drawEllipse(c, r, r);
+        if (b.count > 1 && r * lod >= 9) {
+            p->setPen(QColor(30, 60, 90));
+            p->drawText(QRectF(c.x() - r, c.y() - r, 2 * r, 2 * r), Qt::AlignCenter, QString::number(b.count));
+        }
+    }
+    p->restore();
+}
@@ -0,0 +1,42 @@
+// networkscene.h
+#pragma once
+
+#include <QGraphicsScene>
+#include <QHash>
+#include <QRectF>
+#include <QVector>
+#include <QPointF>
+
+class SpatialGrid;
+
+/**
+ * 社交网络视图用的场景：缩小到 NodeItem::kClusterLod 以下时，
+ * 在前景层把节点按屏幕上约 kGlyphPixels 像素一格聚合，每格画一个圆 + 人数，
+ * 代替成千上万个各自绘制的小节点。坐标来自 ShowNetwork 维护的 SpatialGrid。
+ * 聚合结果按（格子边长, 网格版本）缓存，并比重绘区多算一圈：只有坐标变了、缩放变了
+ * 或平移出了缓存范围才重新分格，普通重绘只遍历缓存里的格子。
+ */
+class NetworkScene : public QGraphicsScene
+{
+    Q_OBJECT
+public:
+    explicit NetworkScene(QObject* parent = nullptr) : QGraphicsScene(parent) {}
+
+    void setGrid(const SpatialGrid* grid) { grid_ = grid; binVersion_ = ~quint64(0); }
+
+protected:
+    void drawForeground(QPainter* p, const QRectF& rect) override;
+
+private:
+    static constexpr qreal kGlyphPixels = 48.0;
+
+    struct Bin { qreal sx = 0, sy = 0; int count = 0; int cx = 0, cy = 0; };
+    void rebuildBins(const QRectF& area, qreal cell);
+
+    const SpatialGrid* grid_ = nullptr;
+    QVector<QPointF>   points_;                 // rebuildBins 复用的缓冲
+    QHash<quint64, Bin> bins_;                  // 缓存的聚合格
+    QRectF             binArea_;                // bins_ 覆盖的场景区域
+    qreal              binCell_ = 0;
+    quint64            binVersion_ = ~quint64(0);
+};
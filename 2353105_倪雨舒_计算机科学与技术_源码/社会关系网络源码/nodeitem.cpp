@@ -1,8 +1,8 @@
 #include "nodeitem.h"
-#include "edgeitem.h"
 
 #include <QPainter>
 #include <QGraphicsSceneMouseEvent>
+#include <QStyleOptionGraphicsItem>
 
 NodeItem::NodeItem(PersonId id, const QString& name, Role role, QGraphicsItem* parent)
     : QGraphicsObject(parent), id_(id), label_(name), role_(role)
@@ -17,8 +17,12 @@ QRectF NodeItem::boundingRect() const
     return QRectF(-R, -R, 2*R, 2*R);
 }
 
-void NodeItem::paint(QPainter* p, const QStyleOptionGraphicsItem*, QWidget*)
+void NodeItem::paint(QPainter* p, const QStyleOptionGraphicsItem* opt, QWidget*)
 {
+    const qreal lod = opt->levelOfDetailFromTransform(p->worldTransform());
+    // 缩得很远时普通成员由聚合符号代替，只保留当前/好友/推荐几个点
+    if (lod < kClusterLod && role_ == Role::Other) return;
+
     // 统一配色
     QColor c;
     switch (role_) {
@@ -28,10 +32,17 @@ void NodeItem::paint(QPainter* p, const QStyleOptionGraphicsItem*, QWidget*)
     case Role::Other:   c = QColor(135, 206, 250); break;  // 蓝 lightskyblue
     }
 
+    if (lod < kPointLod) {
+        p->setRenderHint(QPainter::Antialiasing, false);
+        p->fillRect(QRectF(-R / 2, -R / 2, R, R), c);
+        return;
+    }
+
     p->setRenderHint(QPainter::Antialiasing, true);
     p->setPen(Qt::NoPen);
     p->setBrush(c);
     p->drawEllipse(boundingRect());
+    if (lod < kLabelLod) return;
 
     // 中间白字标签
     p->setPen(Qt::white);
@@ -44,14 +55,13 @@ void NodeItem::paint(QPainter* p, const QStyleOptionGraphicsItem*, QWidget*)
     p->drawText(-w/2, h/2, label_);
 }
 
-QVariant NodeItem::itemChange(GraphicsItemChange change, const QVariant& value)
+void NodeItem::rebind(PersonId id, const QString& name, Role r)
 {
-    if (change == ItemPositionHasChanged) {
-        for (auto* e : edges_) {
-            if (e) e->adjust();
-        }
-    }
-    return QGraphicsObject::itemChange(change, value);
+    id_    = id;
+    label_ = name;
+    role_  = r;
+    setSelected(false);
+    update();
 }
 
 void NodeItem::mousePressEvent(QGraphicsSceneMouseEvent* ev)
@@ -61,6 +71,13 @@ void NodeItem::mousePressEvent(QGraphicsSceneMouseEvent* ev)
     QGraphicsObject::mousePressEvent(ev);
 }
 
+void NodeItem::mouseReleaseEvent(QGraphicsSceneMouseEvent* ev)
+{
+    QGraphicsObject::mouseReleaseEvent(ev);
+    if (ev->button() == Qt::LeftButton && ev->buttonDownScenePos(Qt::LeftButton) != ev->scenePos())
+        emit dropped(id_);
+}
+
 void NodeItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* ev)
 {
     emit editRequested(id_);
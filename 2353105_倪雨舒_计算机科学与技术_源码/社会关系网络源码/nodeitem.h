@@ -5,22 +5,26 @@
 #include <QCursor>
 #include "socialgraph.h"
 
-class EdgeItem;
-
 class NodeItem : public QGraphicsObject
 {
     Q_OBJECT
 public:
     enum class Role { Current, Friend, Suggest, Other };   // 四态
 
+    // 细节层次阈值（levelOfDetailFromTransform，1 = 原始大小）
+    static constexpr qreal kLabelLod   = 0.55;  // 低于此不画姓名
+    static constexpr qreal kPointLod   = 0.25;  // 低于此只画不抗锯齿的方点
+    static constexpr qreal kClusterLod = 0.10;  // 低于此普通成员交给 NetworkScene 聚合绘制
+
     NodeItem(PersonId id, const QString& name, Role role,
              QGraphicsItem* parent = nullptr);
 
     QRectF boundingRect() const override;
-    void   paint(QPainter* p, const QStyleOptionGraphicsItem*, QWidget*) override;
+    void   paint(QPainter* p, const QStyleOptionGraphicsItem* opt, QWidget*) override;
 
-    void addEdge(EdgeItem* e) { if (e) edges_.push_back(e); }
-    void setRole(Role r) { role_ = r; update(); }
+    void setRole(Role r) { if (role_ != r) { role_ = r; update(); } }
+    void setLabel(const QString& name) { if (label_ != name) { label_ = name; update(); } }
+    void rebind(PersonId id, const QString& name, Role r);   // 对象池复用：换成另一个人
 
     PersonId id()  const { return id_; }
     Role     role() const { return role_; }
@@ -28,10 +32,11 @@ public:
 signals:
     void clicked(PersonId id);
     void editRequested(PersonId id);            // 双击触发
+    void dropped(PersonId id);                  // 拖动后松开
 
 protected:
-    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
     void mousePressEvent(QGraphicsSceneMouseEvent* ev) override;
+    void mouseReleaseEvent(QGraphicsSceneMouseEvent* ev) override;
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* ev) override;
 
 private:
@@ -40,5 +45,4 @@ private:
     PersonId id_{0};
     QString  label_;
     Role     role_{Role::Other};
-    QVector<EdgeItem*> edges_;
 };
@@ -0,0 +1,139 @@
+// shardedhash.h
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+#include <type_traits>
+
+/**
+ * 分片哈希表：按键的低位拆成 kShards 个 QHash，接口取 SocialGraph 用到的 QHash 子集。
+ * - 整表拷贝只复制分片数组（各分片隐式共享，O(kShards)）；
+ * - 拷贝之后第一次写某个键，只分离它所在的那一片（约 n / kShards 个节点），
+ *   而不是像单个 QHash 那样整表复制。SocialGraph 发布快照后的下一次编辑因此与规模基本无关。
+ * 键须为整数（PersonId / GroupId 连续分配，低位即可均匀分片）。
+ */
+template <typename K, typename V>
+class ShardedHash
+{
+public:
+    static constexpr int kShards = 256;            // 2 的幂
+    using Shard = QHash<K, V>;
+
+    ShardedHash() : shards_(kShards) {}
+
+    qsizetype size() const    { return count_; }
+    bool      isEmpty() const { return count_ == 0; }
+    void      clear()         { shards_ = QVector<Shard>(kShards); count_ = 0; }
+    void      reserve(qsizetype n) { for (Shard& s : shards_) s.reserve(n / kShards + 1); }
+
+    bool contains(const K& k) const { return shard(k).contains(k); }
+    V    value(const K& k) const { return shard(k).value(k); }
+    V    value(const K& k, const V& fallback) const { return shard(k).value(k, fallback); }
+    const V* lookup(const K& k) const             // 找不到返回 nullptr，不会分离
+    {
+        const Shard& s = shard(k);
+        auto it = s.constFind(k);
+        return it == s.cend() ? nullptr : &it.value();
+    }
+
+    V& operator[](const K& k)
+    {
+        Shard& s = shard(k);
+        const qsizetype before = s.size();
+        V& v = s[k];
+        count_ += s.size() - before;
+        return v;
+    }
+    void insert(const K& k, const V& v)
+    {
+        Shard& s = shard(k);
+        const qsizetype before = s.size();
+        s.insert(k, v);
+        count_ += s.size() - before;
+    }
+    bool remove(const K& k)
+    {
+        if (!contains(k)) return false;             // 先只读判断，键不存在时不分离
+        shard(k).remove(k);
+        --count_;
+        return true;
+    }
+
+    QList<K> keys() const
+    {
+        QList<K> out;
+        out.reserve(count_);
+        for (const Shard& s : shards_)
+            for (auto it = s.cbegin(); it != s.cend(); ++it) out.push_back(it.key());
+        return out;
+    }
+
+    // 冷路径（压缩/展开邻接表）与单表形式互转
+    QHash<K, V> toHash() const
+    {
+        QHash<K, V> out;
+        out.reserve(count_);
+        for (const Shard& s : shards_)
+            for (auto it = s.cbegin(); it != s.cend(); ++it) out.insert(it.key(), it.value());
+        return out;
+    }
+    static ShardedHash fromHash(const QHash<K, V>& h)
+    {
+        ShardedHash out;
+        out.reserve(h.size());
+        for (auto it = h.cbegin(); it != h.cend(); ++it) out.insert(it.key(), it.value());
+        return out;
+    }
+
+    const QVector<Shard>& shards() const { return shards_; }   // 内存估算用
+
+    // 依次走各分片；可写迭代会分离走到的每一片（与 QHash::begin() 相同）
+    template <bool Const>
+    class Iter
+    {
+        using Outer = std::conditional_t<Const, const QVector<Shard>, QVector<Shard>>;
+        using Inner = std::conditional_t<Const, typename Shard::const_iterator, typename Shard::iterator>;
+    public:
+        Iter(Outer* v, int s) : v_(v), s_(s) { settle(); }
+
+        const K& key() const   { return it_.key(); }
+        decltype(auto) value() const { return it_.value(); }
+        decltype(auto) operator*() const { return it_.value(); }
+        Iter& operator++() { ++it_; if (it_ == end_) { ++s_; settle(); } return *this; }
+        bool operator==(const Iter& o) const { return s_ == o.s_ && (s_ == kShards || it_ == o.it_); }
+        bool operator!=(const Iter& o) const { return !(*this == o); }
+
+    private:
+        void settle()                                   // 停在第一个非空分片的开头
+        {
+            for (; s_ < kShards; ++s_) {
+                if ((*v_)[s_].isEmpty()) continue;
+                it_  = (*v_)[s_].begin();
+                end_ = (*v_)[s_].end();
+                return;
+            }
+        }
+        Outer* v_;
+        int    s_;
+        Inner  it_, end_;
+    };
+    using iterator       = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    iterator       begin()        { return iterator(&shards_, 0); }
+    iterator       end()          { return iterator(&shards_, kShards); }
+    const_iterator begin()  const { return const_iterator(&shards_, 0); }
+    const_iterator end()    const { return const_iterator(&shards_, kShards); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+private:
+    static int index(const K& k) { return int(quint64(k) & (kShards - 1)); }
+    const Shard& shard(const K& k) const { return shards_[index(k)]; }
+    Shard&       shard(const K& k)       { return shards_[index(k)]; }
+
+    QVector<Shard> shards_;
+    qsizetype      count_ = 0;
+};
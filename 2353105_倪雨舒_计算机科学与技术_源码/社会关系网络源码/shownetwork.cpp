@@ -6,7 +6,8 @@
 #include <QDir>
 #include <QCoreApplication>
 #include "nodeitem.h"
-#include "edgeitem.h"
+#include "edgelayer.h"
+#include "networkscene.h"
 #include <QRandomGenerator>
 #include <QGraphicsScene>
 #include <QGraphicsView>
@@ -14,7 +15,17 @@
 #include "editmemberdialog.h"
 #include <QMessageBox>
 #include <QTextEdit>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QThreadPool>
+#include <QPointer>
+#include <QSignalBlocker>
+#include <QWheelEvent>
+#include <QScrollBar>
+#include <QStyleOptionGraphicsItem>
+#include "csvimporter.h"
 #include <algorithm>
+#include <utility>
 
 
 
@@ -68,50 +79,44 @@ static QVector<FoFEntry> buildFoF(SocialGraph& g, PersonId center) {
     return out;
 }
 
-void ShowNetwork::refreshColorsAndInfo()
+// 后台计算结果：着色所需的两个集合 + 信息面板文本
+struct ShowNetwork::RefreshResult
 {
-    if (!graph_.getPerson(current_)) {
-        ui->infoBox->clear();
-        return;
-    }
+    PersonId       center = 0;
+    QSet<PersonId> friends;
+    QSet<PersonId> recSet;
+    QList<PersonId> suggestions;      // 得分最高的前 kEgoSuggestLimit 个，个人视图外圈用
+    QString        info;
+};
+
+// 只读快照上的重活（推荐 + 拼文本），可在任意线程执行
+ShowNetwork::RefreshResult
+ShowNetwork::computeRefresh(const SocialGraph::Snapshot& g, PersonId center)
+{
+    RefreshResult r;
+    r.center = center;
 
     // 1) 分类着色（好友集合）
-    const QSet<PersonId> friends = graph_.friendsOf(current_);
+    r.friends = g.friendsOf(center);
 
     // ★ 修改点 3：使用新规则的推荐结果（已确保 cf>0，并按 score 排好序）
-    const auto recs = graph_.potentialAcquaintances(current_, -1 /*no limit*/, 1.0, 1.0);
+    const auto recs = g.potentialAcquaintances(center, -1 /*no limit*/, 1.0, 1.0);
 
     // 用推荐结果的人集合作为“可能认识的人”集合（与原 FoF 等价）
-    QSet<PersonId> recSet;
-    for (const auto& s : recs) recSet.insert(s.person);
-
-    for (auto it = nodeMap_.begin(); it != nodeMap_.end(); ++it) {
-        PersonId id = it.key();
-        NodeItem* n = it.value();
-        if (!n) continue;
-
-        if (id == current_) {
-            n->setRole(NodeItem::Role::Current);
-        } else if (friends.contains(id)) {
-            n->setRole(NodeItem::Role::Friend);    // 朋友：黄
-        } else if (recSet.contains(id)) {
-            n->setRole(NodeItem::Role::Suggest);   // 可能认识：绿（集合不变）
-        } else {
-            n->setRole(NodeItem::Role::Other);     // 其余：蓝
-        }
-    }
+    for (const auto& s : recs) r.recSet.insert(s.person);
+    for (int i = 0; i < recs.size() && i < kEgoSuggestLimit; ++i) r.suggestions.push_back(recs[i].person);
 
     // 2) 组装显示文本（给 QTextBrowser）
-    const Person* p = graph_.getPerson(current_);
-    QString info;
-    info += QStringLiteral("【成员】%1\n").arg(p ? p->name : QString::number(current_));
+    const Person* p = g.getPerson(center);
+    QString& info = r.info;
+    info += QStringLiteral("【成员】%1\n").arg(p ? p->name : QString::number(center));
 
     // —— 群组信息（原样保留）——
     QMap<GroupType, QStringList> groupsByType;
     if (p) {
         for (GroupId gid : p->groups) {
-            if (const Group* g = graph_.getGroup(gid)) {
-                groupsByType[g->type] << g->name;
+            if (const Group* grp = g.getGroup(gid)) {
+                groupsByType[grp->type] << grp->name;
             }
         }
     }
@@ -136,7 +141,7 @@ void ShowNetwork::refreshColorsAndInfo()
     if (!recs.isEmpty()) {
         info += QStringLiteral("\n【可能认识的人】\n");
         for (const auto& s : recs) {
-            const Person* pp = graph_.getPerson(s.person);
+            const Person* pp = g.getPerson(s.person);
             const QString nm = pp ? pp->name : QString::number(s.person);
 
             // 关联度仍为“共同好友数”，共同群组来自 s.commonGroups（仅当 cf>0 才有意义）
@@ -148,8 +153,61 @@ void ShowNetwork::refreshColorsAndInfo()
     } else {
         info += QStringLiteral("\n【可能认识的人】无\n");
     }
+    return r;
+}
+
+// GUI 线程：按结果给节点上色并刷新面板
+void ShowNetwork::applyRefresh(const RefreshResult& r)
+{
+    // 个人视图：推荐在后台算好后才补上外圈（结果没变就不重排）
+    if (egoMode_ && r.center == egoRingCenter_ && r.suggestions != egoRing2_) {
+        egoRing2_ = r.suggestions;
+        layoutEgoNetwork(r.center);
+    }
+    edgeLayer_->setHighlight(r.center);
+    roleCenter_  = r.center;
+    roleFriends_ = r.friends;
+    roleSuggest_ = r.recSet;
+    for (auto it = nodeMap_.begin(); it != nodeMap_.end(); ++it) {
+        PersonId id = it.key();
+        NodeItem* n = it.value();
+        if (!n) continue;
+
+        if (id == r.center) {
+            n->setRole(NodeItem::Role::Current);
+        } else if (r.friends.contains(id)) {
+            n->setRole(NodeItem::Role::Friend);    // 朋友：黄
+        } else if (r.recSet.contains(id)) {
+            n->setRole(NodeItem::Role::Suggest);   // 可能认识：绿（集合不变）
+        } else {
+            n->setRole(NodeItem::Role::Other);     // 其余：蓝
+        }
+    }
+    ui->infoBox->setPlainText(r.info);
+    scheduleViewSync();                    // 远景下只实体化高亮的几类人，集合变了要补
+}
 
-    ui->infoBox->setPlainText(info);
+// 取快照（O(1)）后把推荐计算丢到线程池，拖动/编辑不再被卡住；
+// 结果回到 GUI 线程时若已有更新的请求（ticket 不符）或窗口已销毁则丢弃。
+void ShowNetwork::refreshColorsAndInfo()
+{
+    const quint64 ticket = ++refreshTicket_;
+    if (!graph_.getPerson(current_)) {
+        ui->infoBox->clear();
+        return;
+    }
+
+    const SocialGraph::SnapshotPtr snap = graph_.snapshot();
+    const PersonId center = current_;
+    const QPointer<ShowNetwork> self(this);
+
+    QThreadPool::globalInstance()->start([snap, center, ticket, self]{
+        const RefreshResult r = computeRefresh(*snap, center);
+        QMetaObject::invokeMethod(qApp, [self, ticket, r]{
+            if (!self || self->refreshTicket_ != ticket) return;
+            self->applyRefresh(r);
+        }, Qt::QueuedConnection);
+    });
 }
 
 
@@ -161,14 +219,49 @@ ShowNetwork::ShowNetwork(QWidget *parent)
     ui->infoBox->setWordWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
     ui->infoBox->setPlaceholderText(u8"点击图中的节点查看详细信息…");
 
-    scene_ = new QGraphicsScene(this);
+    scene_ = new NetworkScene(this);
     scene_->setSceneRect(-600, -400, 1200, 800);
+    scene_->setGrid(&grid_);
     ui->graphicsView->setScene(scene_);
     ui->graphicsView->setRenderHint(QPainter::Antialiasing, true);
+    ui->graphicsView->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    ui->graphicsView->viewport()->installEventFilter(this);
+    resetEdgeLayer();
 
     connect(scene_, &QGraphicsScene::selectionChanged,
             this, &ShowNetwork::onSceneSelectionChanged);
 
+    layout_      = new ForceLayout(this);
+    layoutTimer_ = new QTimer(this);
+    layoutTimer_->setInterval(33);                   // 约 30 帧/秒
+    connect(layoutTimer_, &QTimer::timeout,  this, &ShowNetwork::applyLayoutFrame);
+    // 自然收敛的通知是排队送达的：送到前用户可能已经开了新一轮，旧的通知不能把新一轮停掉
+    connect(layout_, &ForceLayout::finished, this, [this](quint64 gen) {
+        if (gen == layout_->generation()) finishLayout();
+    });
+
+    flushTimer_ = new QTimer(this);
+    flushTimer_->setSingleShot(true);
+    flushTimer_->setTimerType(Qt::PreciseTimer);
+    flushTimer_->setInterval(16);                    // 一帧（60 Hz）
+    connect(flushTimer_, &QTimer::timeout, this, &ShowNetwork::flushMoved);
+
+    egoAnim_ = new QVariantAnimation(this);
+    egoAnim_->setStartValue(0.0);
+    egoAnim_->setEndValue(1.0);
+    egoAnim_->setDuration(400);
+    egoAnim_->setEasingCurve(QEasingCurve::OutCubic);
+    connect(egoAnim_, &QVariantAnimation::valueChanged, this,
+            [this](const QVariant& v){ stepEgoAnimation(v.toReal()); });
+
+    // 平移、缩放、改窗口大小后按新视口增减节点图元（同一帧内多次触发只做一次）
+    viewSyncTimer_ = new QTimer(this);
+    viewSyncTimer_->setSingleShot(true);
+    viewSyncTimer_->setInterval(16);
+    connect(viewSyncTimer_, &QTimer::timeout, this, &ShowNetwork::syncVisibleNodes);
+    connect(ui->graphicsView->horizontalScrollBar(), &QScrollBar::valueChanged, this, &ShowNetwork::scheduleViewSync);
+    connect(ui->graphicsView->verticalScrollBar(),   &QScrollBar::valueChanged, this, &ShowNetwork::scheduleViewSync);
+
     // 数据文件路径
     dataPath_ = QDir(QCoreApplication::applicationDirPath()).filePath("social_network.json");
 
@@ -194,11 +287,20 @@ ShowNetwork::ShowNetwork(QWidget *parent)
     auto ids = graph_.allPersons();
     if (!ids.isEmpty()) {
         current_ = ids.first();   // 选第一个为中心
-        showFullNetwork();
+        redrawScene();
     } else {
         scene_->clear();          // 理论上不会到这里
+        resetEdgeLayer();
     }
 
+    // 之后的增删改只做增量更新
+    connect(&graph_, &SocialGraph::personAdded,       this, &ShowNetwork::onPersonAdded);
+    connect(&graph_, &SocialGraph::personRemoved,     this, &ShowNetwork::onPersonRemoved);
+    connect(&graph_, &SocialGraph::personUpdated,     this, &ShowNetwork::onPersonUpdated);
+    connect(&graph_, &SocialGraph::friendshipAdded,   this, &ShowNetwork::onFriendshipAdded);
+    connect(&graph_, &SocialGraph::friendshipRemoved, this, &ShowNetwork::onFriendshipRemoved);
+    connect(&graph_, &SocialGraph::graphReset,        this, &ShowNetwork::redrawScene);
+
     // 退出时保存
     connect(qApp, &QCoreApplication::aboutToQuit,
             this, &ShowNetwork::saveToDisk);
@@ -206,8 +308,27 @@ ShowNetwork::ShowNetwork(QWidget *parent)
 
 ShowNetwork::~ShowNetwork()
 {
+    qDeleteAll(pool_);                     // 池里的图元不在场景中，场景不会替我们删
     delete ui;
 }
+bool ShowNetwork::eventFilter(QObject* watched, QEvent* ev)
+{
+    if (watched == ui->graphicsView->viewport() && ev->type() == QEvent::Wheel) {
+        auto* we = static_cast<QWheelEvent*>(ev);
+        if (we->modifiers() & Qt::ControlModifier) {
+            // 缩放范围约 2% ~ 400%，各图元按 levelOfDetail 自行简化
+            const qreal factor = qPow(1.0015, we->angleDelta().y());
+            const qreal scale  = ui->graphicsView->transform().m11() * factor;
+            if (scale > 0.02 && scale < 4.0) ui->graphicsView->scale(factor, factor);
+            scheduleViewSync();
+            return true;
+        }
+    }
+    if (watched == ui->graphicsView->viewport() && ev->type() == QEvent::Resize)
+        scheduleViewSync();
+    return QWidget::eventFilter(watched, ev);
+}
+
 void ShowNetwork::on_back_Button_clicked()
 {
     emit returnToMain();
@@ -229,7 +350,7 @@ void ShowNetwork::onSceneSelectionChanged()
             PersonId id = static_cast<qulonglong>(el->data(0).toULongLong());
             if (graph_.getPerson(id)) {
                 current_ = id;
-                showFullNetwork();
+                refreshColorsAndInfo();
                 break;
             }
         }
@@ -283,97 +404,379 @@ ShowNetwork::radialPositions(const QPointF& c,
     return pos;
 }
 
+// 个人视图：中心 + 一圈好友（按好友数取前 kEgoFriendLimit 个）+ 外圈推荐（前 kEgoSuggestLimit 个）。
+// 推荐不在 GUI 线程算：先沿用同一中心上次的结果（换了中心就先空着），
+// refreshColorsAndInfo 的后台结果回来后由 applyRefresh 补齐外圈。
+void ShowNetwork::drawEgoNetwork(PersonId center)
+{
+    if (center != egoRingCenter_) egoRing2_.clear();
+    egoRingCenter_ = center;
+    layoutEgoNetwork(center);
+    refreshColorsAndInfo();
+}
+
+// 仍在新视图里的图元原地复用并动画移到新位置，离开的删除，新来的从原中心处长出来。
+void ShowNetwork::layoutEgoNetwork(PersonId center)
+{
+    if (layout_->isRunning()) finishLayout();
+    flushMoved();
+    egoAnim_->stop();
+
+    // 1) 选人
+    QList<PersonId> ring1, ring2;
+    const bool hasCenter = graph_.getPerson(center) != nullptr;
+    if (hasCenter) {
+        QVector<QPair<int, PersonId>> byDegree;        // (-好友数, id)：升序即好友多的在前
+        const QSet<PersonId> friends = graph_.friendsOf(center);
+        for (PersonId f : friends)
+            byDegree.push_back({ -int(graph_.friendsOf(f).size()), f });
+        const int keep = qMin<int>(kEgoFriendLimit, byDegree.size());
+        std::partial_sort(byDegree.begin(), byDegree.begin() + keep, byDegree.end());
+        for (int i = 0; i < keep; ++i) ring1.push_back(byDegree[i].second);
+        std::sort(ring1.begin(), ring1.end());         // 环上按 id 排，重新居中时位置更稳定
+
+        // 沿用的推荐可能已过时：去掉已删除的人和已成为好友的人
+        for (PersonId s : egoRing2_)
+            if (s != center && !friends.contains(s) && graph_.getPerson(s)) ring2.push_back(s);
+    }
+
+    // 2) 半径随人数增大，保证环上相邻节点间距不小于 kNodeGap
+    const double r1 = qMax(220.0, ring1.size() * kNodeGap / (2 * M_PI));
+    const double r2 = qMax(qMax(330.0, r1 + kNodeGap * 1.2), ring2.size() * kNodeGap / (2 * M_PI));
+    QMap<PersonId, QPointF> target = radialPositions(QPointF(0, 0), ring1, ring2, r1, r2);
+    if (hasCenter) target.insert(center, QPointF(0, 0));
+
+    // 3) 图元增删：只动差集
+    for (PersonId id : nodeMap_.keys())
+        if (!target.contains(id)) removeNodeItem(id);
+    NodeItem* oldCenter = nodeMap_.value(center, nullptr);
+    const QPointF origin = oldCenter ? oldCenter->pos() : QPointF(0, 0);
+    egoMoves_.clear();
+    for (auto it = target.cbegin(); it != target.cend(); ++it) {
+        NodeItem* n = nodeMap_.value(it.key(), nullptr);
+        if (!n) n = createNodeItem(it.key(), origin);
+        if (n) egoMoves_.insert(it.key(), { n->pos(), it.value() });
+    }
+
+    // 4) 边：只连显示中的人两两之间，O(k²) 与全网规模无关
+    const QList<PersonId> shown = target.keys();
+    for (int i = 0; i < shown.size(); ++i) {
+        const QSet<PersonId> fi = graph_.friendsOf(shown[i]);
+        for (int j = i + 1; j < shown.size(); ++j)
+            if (fi.contains(shown[j])) addEdge(shown[i], shown[j]);
+    }
+
+    const qreal half = r2 + kNodeGap;
+    scene_->setSceneRect(QRectF(-half, -half, 2 * half, 2 * half).united(QRectF(-600, -400, 1200, 800)));
+    egoAnim_->start();
+}
+
+void ShowNetwork::stepEgoAnimation(qreal t)
+{
+    QGraphicsItem* grabbed = scene_->mouseGrabberItem();
+    for (auto it = egoMoves_.cbegin(); it != egoMoves_.cend(); ++it) {
+        NodeItem* n = nodeMap_.value(it.key(), nullptr);
+        if (!n || n == grabbed) continue;              // 用户正拖着的不抢
+        const QPointF& from = it.value().first;
+        const QPointF& to   = it.value().second;
+        n->setPos(from + (to - from) * t);             // 经 x/yChanged 合并到每帧一次
+    }
+}
+
+void ShowNetwork::scheduleEgoRedraw()
+{
+    if (egoRedrawQueued_) return;
+    egoRedrawQueued_ = true;
+    QMetaObject::invokeMethod(this, [this]{
+        egoRedrawQueued_ = false;
+        if (egoMode_) drawEgoNetwork(current_);
+    }, Qt::QueuedConnection);
+}
+
+void ShowNetwork::on_ego_Button_toggled(bool on)
+{
+    if (on == egoMode_) return;
+    clearScene();                                      // 先按旧模式收尾（会 flushMoved）
+    egoMode_ = on;
+    ui->ego_Button->setText(on ? u8"全网视图" : u8"个人视图");
+    ui->layout_Button->setEnabled(!on);
+    ui->layout_stop_Button->setEnabled(!on);
+    redrawScene();
+}
+
+void ShowNetwork::resetEdgeLayer()
+{
+    edgeLayer_ = new EdgeLayer;
+    scene_->addItem(edgeLayer_);
+}
 
 void ShowNetwork::addEdge(PersonId a, PersonId b)
 {
-    auto* na = nodeMap_.value(a, nullptr);
-    auto* nb = nodeMap_.value(b, nullptr);
-    if (!na || !nb) return;
+    if (!grid_.contains(a) || !grid_.contains(b)) return;     // 未登记坐标（个人视图外）的人不连
+    edgeLayer_->addEdge(a, b, nodePos(a), nodePos(b));
+}
 
-    auto* e = new EdgeItem(na, nb);
-    scene_->addItem(e);
+void ShowNetwork::removeEdge(PersonId a, PersonId b)
+{
+    edgeLayer_->removeEdge(a, b);
 }
 
-void ShowNetwork::showFullNetwork()
+QPointF ShowNetwork::randomFreePos(int maxTry)
 {
-    scene_->clear();
-    nodeMap_.clear();
-    edgeItems_.clear();
-
-    const QRectF world(-550, -350, 1100, 700);
-    auto* rng = QRandomGenerator::global();
-
-    auto randomFreePos = [&](int maxTry = 80)->QPointF {
-        for (int k=0; k<maxTry; ++k) {
-            const qreal x = world.left() + rng->bounded(world.width());
-            const qreal y = world.top()  + rng->bounded(world.height());
-            const QPointF p(x, y);
-            bool ok = true;
-            for (NodeItem* n : nodeMap_.values()) {
-                if (QLineF(n->pos(), p).length() < 90) { ok = false; break; }
-            }
-            if (ok) return p;
-        }
-        return QPointF(0,0);
-    };
+    return grid_.freePosition(QRectF(-550, -350, 1100, 700), kNodeGap, maxTry);
+}
 
-    // 1) 节点
-    for (PersonId id : graph_.allPersons()) {
-        const Person* per = graph_.getPerson(id);
-        if (!per) continue;
+void ShowNetwork::markMoved(PersonId id)
+{
+    bool& byUser = dirtyNodes_[id];
+    byUser = byUser || !applyingLayout_;
+    if (!flushTimer_->isActive()) flushTimer_->start();
+}
+
+// 一帧内同一节点的多次 x/yChanged 只处理一次；相连的边也只重算一次
+void ShowNetwork::flushMoved()
+{
+    flushTimer_->stop();
+    if (dirtyNodes_.isEmpty()) return;
+    const QHash<PersonId, bool> dirty = std::exchange(dirtyNodes_, {});
+    const bool pinning = layout_->isRunning();
+    for (auto it = dirty.cbegin(); it != dirty.cend(); ++it) {
+        NodeItem* n = nodeMap_.value(it.key(), nullptr);
+        if (!n) continue;
+        const QPointF p = n->pos();
+        if (!egoMode_) graph_.setPosition(it.key(), p);
+        grid_.move(it.key(), p);
+        edgeLayer_->nodeMoved(it.key(), p);
+        if (pinning && it.value()) layout_->pin(it.key(), p);   // 用户拖过的点固定住
+    }
+}
+
+void ShowNetwork::onNodeDropped(NodeItem* n)
+{
+    flushMoved();                            // 吸附前先让 grid_ 与当前位置一致
+    if (!egoMode_) {                         // 个人视图里的位置是临时的，不吸附
+        const QPointF p = grid_.freePositionNear(n->pos(), kNodeGap, n->id());
+        if (p != n->pos()) {
+            n->setPos(p);                    // 经 x/yChanged 登记
+            flushMoved();                    // 立即同步，免得下一帧又把它钉住
+        }
+    }
+    if (layout_->isRunning()) layout_->unpin(n->id());     // 松手即交还给布局
+    if (egoMode_) return;
+    graph_.saveToFile(dataPath_);
+}
 
-        QPointF pos = graph_.hasPosition(id) ? graph_.positionOf(id)
-                                             : randomFreePos();
-        if (!graph_.hasPosition(id)) graph_.setPosition(id, pos);
+void ShowNetwork::placePerson(PersonId id)
+{
+    if (!graph_.getPerson(id)) return;
 
-        NodeItem::Role role = (id==current_) ? NodeItem::Role::Current
-                                               : NodeItem::Role::Other;
+    QPointF pos = graph_.hasPosition(id) ? graph_.positionOf(id)
+                                         : randomFreePos();
+    if (!graph_.hasPosition(id)) graph_.setPosition(id, pos);
+    grid_.insert(id, pos);
+    scheduleViewSync();
+}
 
-        auto* n = new NodeItem(id, per->name, role);
-        connect(n, &NodeItem::editRequested, this, &ShowNetwork::editMember);
+NodeItem* ShowNetwork::createNodeItem(PersonId id, const QPointF& pos)
+{
+    const Person* per = graph_.getPerson(id);
+    if (!per) return nullptr;
 
+    NodeItem* n = pool_.isEmpty() ? newNodeItem() : pool_.takeLast();
+    n->rebind(id, per->name, roleFor(id));
+    {
+        const QSignalBlocker quiet(n);       // 放到初始位置不算移动
         n->setPos(pos);
-        scene_->addItem(n);
+    }
+    scene_->addItem(n);
+    grid_.insert(id, pos);
+    nodeMap_.insert(id, n);
+    return n;
+}
+
+NodeItem* ShowNetwork::newNodeItem()
+{
+    auto* n = new NodeItem(0, QString(), NodeItem::Role::Other);
+    connect(n, &NodeItem::editRequested, this, &ShowNetwork::editMember);
+
+    connect(n, &NodeItem::clicked, this, [=](PersonId pid){
+        current_ = pid;
+        if (egoMode_) scheduleEgoRedraw();       // 个人视图：以被点的人重新居中
+        else          refreshColorsAndInfo();
+    });
+
+    // 拖动过程中只登记，下一帧统一更新内存里的坐标，松手时再落盘
+    auto moved = [=]{ markMoved(n->id()); };
+    connect(n, &QGraphicsObject::xChanged, this, moved);
+    connect(n, &QGraphicsObject::yChanged, this, moved);
+    connect(n, &NodeItem::dropped, this, [=]{ onNodeDropped(n); });
+    return n;
+}
 
-        connect(n, &NodeItem::clicked, this, [=](PersonId pid){
-            current_ = pid;
-            refreshColorsAndInfo();
-        });
+void ShowNetwork::recycleNodeItem(NodeItem* n)
+{
+    scene_->removeItem(n);
+    if (pool_.size() < kPoolLimit) pool_.push_back(n);
+    else                           delete n;
+}
+
+void ShowNetwork::removeNodeItem(PersonId id)
+{
+    NodeItem* n = nodeMap_.take(id);
+    dirtyNodes_.remove(id);
+    grid_.remove(id);
+    edgeLayer_->removeNode(id);
+    if (n) recycleNodeItem(n);
+}
+
+QPointF ShowNetwork::nodePos(PersonId id) const
+{
+    if (NodeItem* n = nodeMap_.value(id, nullptr)) return n->pos();
+    return graph_.positionOf(id);
+}
+
+NodeItem::Role ShowNetwork::roleFor(PersonId id) const
+{
+    const PersonId center = roleCenter_ ? roleCenter_ : current_;
+    if (id == center)                return NodeItem::Role::Current;
+    if (roleFriends_.contains(id))   return NodeItem::Role::Friend;
+    if (roleSuggest_.contains(id))   return NodeItem::Role::Suggest;
+    return NodeItem::Role::Other;
+}
+
+void ShowNetwork::scheduleViewSync()
+{
+    if (!egoMode_ && !viewSyncTimer_->isActive()) viewSyncTimer_->start();
+}
 
-        connect(n, &QGraphicsObject::xChanged, this, [=]{
-            graph_.setPosition(id, n->pos());
-            graph_.saveToFile(dataPath_);
-        });
-        connect(n, &QGraphicsObject::yChanged, this, [=]{
-            graph_.setPosition(id, n->pos());
-            graph_.saveToFile(dataPath_);
-        });
+// 视口外扩 1/4 作为预取区；回收用再大一倍的框，来回小幅平移时不反复建删。
+// 缩到聚合层次以下时普通成员不画，只实体化当前/好友/推荐。
+void ShowNetwork::syncVisibleNodes()
+{
+    if (egoMode_) return;
+    flushMoved();
+
+    QGraphicsView* v = ui->graphicsView;
+    const QRectF view = v->mapToScene(v->viewport()->rect()).boundingRect();
+    const qreal  m    = qMax(view.width(), view.height()) * 0.25 + kNodeGap;
+    const QRectF want = view.adjusted(-m, -m, m, m);
+    const QRectF keep = view.adjusted(-2 * m, -2 * m, 2 * m, 2 * m);
+    const bool   far  = QStyleOptionGraphicsItem::levelOfDetailFromTransform(v->transform())
+                        < NodeItem::kClusterLod;
+
+    QGraphicsItem* grabbed = scene_->mouseGrabberItem();
+    for (auto it = nodeMap_.begin(); it != nodeMap_.end(); ) {
+        NodeItem* n = it.value();
+        const bool stay = n == grabbed ||
+                          (keep.contains(n->pos()) && (!far || roleFor(it.key()) != NodeItem::Role::Other));
+        if (stay) { ++it; continue; }
+        recycleNodeItem(n);
+        it = nodeMap_.erase(it);
+    }
 
-        nodeMap_.insert(id, n);
+    auto show = [&](PersonId id){
+        if (nodeMap_.contains(id) || !graph_.hasPosition(id)) return;
+        const QPointF p = graph_.positionOf(id);
+        if (want.contains(p)) createNodeItem(id, p);
+    };
+    if (far) {
+        show(roleCenter_ ? roleCenter_ : current_);
+        for (PersonId id : roleFriends_) show(id);
+        for (PersonId id : roleSuggest_) show(id);
+    } else {
+        QVector<PersonId> ids;
+        grid_.idsIn(want, ids);
+        for (PersonId id : ids) show(id);
     }
+}
+
+void ShowNetwork::clearScene()
+{
+    if (layout_->isRunning()) finishLayout();
+    flushMoved();
+    egoAnim_->stop();
+    egoMoves_.clear();
+    scene_->clear();
+    nodeMap_.clear();
+    resetEdgeLayer();
+    grid_.clear();
+}
+
+void ShowNetwork::redrawScene()
+{
+    if (egoMode_) drawEgoNetwork(current_);
+    else          showFullNetwork();
+}
+
+void ShowNetwork::showFullNetwork()
+{
+    clearScene();
+
+    // 1) 节点：先登记已有坐标，新人再找空位，避免压到后面才出现的老节点
+    const QList<PersonId> ids = graph_.allPersons();
+    grid_.reserve(ids.size());
+    for (PersonId id : ids)
+        if (graph_.hasPosition(id)) grid_.insert(id, graph_.positionOf(id));
+    for (PersonId id : ids) placePerson(id);
+    const QRectF all = grid_.bounds().adjusted(-kNodeGap, -kNodeGap, kNodeGap, kNodeGap);
+    scene_->setSceneRect(all.united(QRectF(-600, -400, 1200, 800)));
 
     // 边（全网、无向去重）
     const auto edges = graph_.allFriendEdges();
-    for (const auto& e : edges) {
-        const PersonId a = e.first;
-        const PersonId b = e.second;
-        auto* na = nodeMap_.value(a, nullptr);
-        auto* nb = nodeMap_.value(b, nullptr);
-        if (na && nb) {
-            auto* edge = new EdgeItem(na, nb);
-            scene_->addItem(edge);
-            edgeItems_.push_back(edge);
-        }
-    }
+    edgeLayer_->reserve(int(edges.size()));
+    for (const auto& e : edges) addEdge(e.first, e.second);
 
-    // 初次进入也刷新一次颜色与说明
+    // 图元只建视口附近的；初次进入也刷新一次颜色与说明
+    syncVisibleNodes();
     refreshColorsAndInfo();
 }
 
+// 以下几个槽由 SocialGraph 的变更通知同步触发：只动受影响的节点/边，
+// 调用方改完数据后自行 refreshColorsAndInfo() 一次即可
+void ShowNetwork::onPersonAdded(PersonId id)
+{
+    if (egoMode_) { scheduleEgoRedraw(); return; }
+    if (layout_->isRunning()) finishLayout();      // 下标已失效，先收尾
+    if (!grid_.contains(id)) placePerson(id);
+}
+
+void ShowNetwork::onPersonRemoved(PersonId id)
+{
+    if (egoMode_) { scheduleEgoRedraw(); return; }
+    if (layout_->isRunning()) finishLayout();
+    removeNodeItem(id);
+}
+
+void ShowNetwork::onPersonUpdated(PersonId id)
+{
+    NodeItem* n = nodeMap_.value(id, nullptr);
+    const Person* p = graph_.getPerson(id);
+    if (n && p) n->setLabel(p->name);
+}
+
+void ShowNetwork::onFriendshipAdded(PersonId a, PersonId b)
+{
+    if (egoMode_) { scheduleEgoRedraw(); return; }
+    if (layout_->isRunning()) finishLayout();
+    addEdge(a, b);
+}
+
+void ShowNetwork::onFriendshipRemoved(PersonId a, PersonId b)
+{
+    if (egoMode_) {
+        removeEdge(a, b);                      // 重画只增不删两端都留在视图里的边
+        scheduleEgoRedraw();
+        return;
+    }
+    if (layout_->isRunning()) finishLayout();
+    removeEdge(a, b);
+}
+
 
 
 void ShowNetwork::saveToDisk()
 {
+    flushMoved();
     graph_.saveToFile(dataPath_);
 }
 void ShowNetwork::on_add_new_member_Button_clicked()
@@ -416,9 +819,9 @@ void ShowNetwork::on_add_new_member_Button_clicked()
     // 保存到 JSON
     graph_.saveToFile(dataPath_);
 
-    // 以新成员为中心刷新
+    // 以新成员为中心刷新（节点和边已由变更通知补到场景里）
     current_ = pid;
-    showFullNetwork();
+    refreshColorsAndInfo();
 }
 void ShowNetwork::editMember(PersonId id)
 {
@@ -442,7 +845,7 @@ void ShowNetwork::editMember(PersonId id)
 
         graph_.removePerson(id);          // 会清理好友与群组倒排
         graph_.saveToFile(dataPath_);
-        showFullNetwork();
+        refreshColorsAndInfo();
         return;
     }
 
@@ -488,7 +891,7 @@ void ShowNetwork::editMember(PersonId id)
 
     //保存与刷新
     graph_.saveToFile(dataPath_);
-    showFullNetwork();
+    refreshColorsAndInfo();
 }
 
 void ShowNetwork::on_check_group_Button_clicked()
@@ -568,3 +971,132 @@ void ShowNetwork::on_check_group_Button_clicked()
     // 4) 输出到左侧 QTextBrowser
     ui->infoBox->setPlainText(out);
 }
+
+void ShowNetwork::on_import_csv_Button_clicked()
+{
+    const QString csvPath = QFileDialog::getOpenFileName(
+        this, u8"选择成员 CSV", QString(), u8"CSV 文件 (*.csv *.txt);;所有文件 (*)");
+    if (csvPath.isEmpty()) return;
+    // 边表可选：取消即只导入成员
+    const QString edgePath = QFileDialog::getOpenFileName(
+        this, u8"选择好友边表（可取消）", QFileInfo(csvPath).path(),
+        u8"边表 (*.csv *.txt *.tsv);;所有文件 (*)");
+
+    QProgressDialog progress(u8"正在导入…", QString(), 0, 1000, this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(300);
+
+    CsvImporter importer(graph_);
+    QSignalBlocker bulk(&graph_);                    // 批量导入不逐条更新场景，结束后整体重绘
+    int stage = 0;                                   // 0=成员 1=边表，各占进度条一半
+    const int stages = edgePath.isEmpty() ? 1 : 2;
+    connect(&importer, &CsvImporter::progress, &progress, [&](qint64 done, qint64 total){
+        const qint64 part = total > 0 ? done * 1000 / total : 1000;
+        progress.setValue(int((stage * 1000 + part) / stages));
+    });
+
+    if (!importer.importMembers(csvPath)) {
+        bulk.unblock();
+        redrawScene();                               // 可能已写入一部分
+        QMessageBox::warning(this, u8"导入失败", importer.errorString());
+        return;
+    }
+    stage = 1;
+    if (!edgePath.isEmpty() && !importer.importFriendships(edgePath)) {
+        QMessageBox::warning(this, u8"导入失败", importer.errorString());
+    }
+    progress.setValue(1000);
+    bulk.unblock();
+
+    graph_.saveToFile(dataPath_);
+    if (!graph_.getPerson(current_)) {
+        const auto ids = graph_.allPersons();
+        current_ = ids.isEmpty() ? 0 : ids.first();
+    }
+    redrawScene();
+
+    QMessageBox::information(this, u8"导入完成",
+                             QStringLiteral("新增成员 %1 人，好友关系 %2 条")
+                                 .arg(importer.importedPersons())
+                                 .arg(importer.importedEdges()));
+}
+
+void ShowNetwork::on_memory_report_Button_clicked()
+{
+    ++refreshTicket_;                      // 丢弃尚未回来的推荐结果，免得覆盖报告
+    ui->infoBox->setPlainText(graph_.memoryReport().toText());
+}
+
+void ShowNetwork::on_layout_Button_clicked()
+{
+    if (layout_->isRunning()) {
+        if (layout_->isPaused()) { layout_->resume(); ui->layout_Button->setText(u8"暂停"); }
+        else                     { layout_->pause();  ui->layout_Button->setText(u8"继续"); }
+        return;
+    }
+
+    // 全体成员都参与（多数没有图元），坐标取 graph_
+    flushMoved();
+    const QList<PersonId> all = graph_.allPersons();
+    QVector<PersonId> ids;
+    QVector<QPointF>  pos;
+    QHash<PersonId, int> index;
+    ids.reserve(all.size());
+    pos.reserve(all.size());
+    index.reserve(all.size());
+    for (PersonId id : all) {
+        if (!grid_.contains(id)) continue;
+        index.insert(id, int(ids.size()));
+        ids.push_back(id);
+        pos.push_back(nodePos(id));
+    }
+    QVector<QPair<int, int>> edges;
+    edges.reserve(edgeLayer_->edgeCount());
+    for (int i = 0; i < edgeLayer_->edgeCount(); ++i) {
+        const auto ends = edgeLayer_->endsAt(i);
+        edges.push_back({ index.value(ends.first), index.value(ends.second) });
+    }
+
+    layout_->start(ids, pos, edges);
+    layoutTimer_->start();
+    ui->layout_Button->setText(u8"暂停");
+}
+
+void ShowNetwork::on_layout_stop_Button_clicked()
+{
+    if (layout_->isRunning()) finishLayout();
+}
+
+void ShowNetwork::applyLayoutFrame()
+{
+    QVector<QPointF> frame;
+    if (!layout_->takeFrame(frame)) return;
+
+    const QVector<PersonId>& ids = layout_->ids();
+    applyingLayout_ = true;
+    for (int i = 0; i < ids.size() && i < frame.size(); ++i) {
+        NodeItem* n = nodeMap_.value(ids[i], nullptr);
+        if (n) {
+            if (!n->isUnderMouse()) n->setPos(frame[i]);    // 经 x/yChanged 登记
+        } else if (grid_.contains(ids[i])) {                // 视口外没有图元：直接改数据
+            graph_.setPosition(ids[i], frame[i]);
+            grid_.move(ids[i], frame[i]);
+            edgeLayer_->nodeMoved(ids[i], frame[i]);
+        }
+    }
+    applyingLayout_ = false;
+    flushMoved();                                    // 本来就是一帧一次，直接同步
+    scheduleViewSync();                              // 有人移进 / 移出视口
+}
+
+void ShowNetwork::finishLayout()
+{
+    layout_->stop();
+    layoutTimer_->stop();
+    applyLayoutFrame();                              // 最后一轮结果（内含 flushMoved）
+    // 布局后范围通常超出初始场景，放大场景矩形以便滚动查看（视口外的人没有图元，按网格坐标算）
+    scene_->setSceneRect(grid_.bounds().adjusted(-60, -60, 60, 60)
+                             .united(QRectF(-600, -400, 1200, 800)));
+    ui->layout_Button->setText(u8"自动布局");
+    graph_.saveToFile(dataPath_);
+}
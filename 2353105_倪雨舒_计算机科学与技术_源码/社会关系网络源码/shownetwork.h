@@ -7,12 +7,17 @@
 #include <QGraphicsLineItem>
 #include <QGraphicsSimpleTextItem>
 #include <QMap>
+#include <QTimer>
+#include <QVariantAnimation>
 #include "socialgraph.h"
 #include "addmemberdialog.h"
 #include "nodeitem.h"
+#include "spatialgrid.h"
+#include "forcelayout.h"
 
 class NodeItem;
-class EdgeItem;
+class EdgeLayer;
+class NetworkScene;
 namespace Ui { class ShowNetwork; }
 
 class ShowNetwork : public QWidget
@@ -22,6 +27,9 @@ public:
     explicit ShowNetwork(QWidget *parent = nullptr);
     ~ShowNetwork();
 
+protected:
+    bool eventFilter(QObject* watched, QEvent* ev) override;   // 视图里 Ctrl+滚轮缩放
+
 private slots:
     void on_back_Button_clicked();
     void on_exit_Button_clicked();
@@ -29,6 +37,18 @@ private slots:
     void on_add_new_member_Button_clicked();
     void editMember(PersonId id);
     void on_check_group_Button_clicked();
+    void on_import_csv_Button_clicked();   // 批量导入成员 CSV / 好友边表
+    void on_memory_report_Button_clicked();  // 显示 SocialGraph 内存占用估算
+    void on_layout_Button_clicked();         // 力导向布局：开始 / 暂停 / 继续
+    void on_layout_stop_Button_clicked();    // 结束布局并保存坐标
+    void on_ego_Button_toggled(bool on);     // 个人视图 / 全网视图
+
+    // SocialGraph 变更通知 → 只修补受影响的图元
+    void onPersonAdded(PersonId id);
+    void onPersonRemoved(PersonId id);
+    void onPersonUpdated(PersonId id);
+    void onFriendshipAdded(PersonId a, PersonId b);
+    void onFriendshipRemoved(PersonId a, PersonId b);
 
 private:
     Ui::ShowNetwork *ui;
@@ -38,21 +58,57 @@ private:
     PersonId    current_{0};
 
     // 仅用于可视化
-    QGraphicsScene* scene_{nullptr};
-    QMap<PersonId, NodeItem*> nodeMap_;
-    QVector<EdgeItem*> edgeItems_;
-    QVector<QGraphicsLineItem*> edges_;
+    NetworkScene*   scene_{nullptr};                         // 缩得很远时在前景画聚合符号
+    QMap<PersonId, NodeItem*> nodeMap_;                      // 只含当前已实体化（视口附近）的节点
+    EdgeLayer* edgeLayer_{nullptr};                          // 全部好友边画在这一个图元里
+    static constexpr qreal kNodeGap = 90.0;                  // 节点圆心之间的最小距离
+    SpatialGrid grid_{kNodeGap};                             // 节点坐标索引：放置、碰撞检查、拖放吸附
 
     // 构建/刷新
     void buildDemoData();
-    void drawEgoNetwork(PersonId center, int suggestLimit = 12);
+    void drawEgoNetwork(PersonId center);
 
     // 绘制辅助
     enum class Role { Current, Known, Maybe };
     QBrush roleBrush(Role r) const;
     void   drawLegend();
 
+    void   placePerson(PersonId id);           // 全网视图：确定坐标并登记到 grid_，图元按视口再建
+    NodeItem* createNodeItem(PersonId id, const QPointF& pos);   // 取池中或新建图元，登记到 nodeMap_
+    void   removeNodeItem(PersonId id);        // 连同相连的边一起删
+    QPointF nodePos(PersonId id) const;        // 有图元取图元位置，否则取 graph_ 中的坐标
+
+    // 视口虚拟化：全网视图只为视口（外扩一圈）里的人建 NodeItem，移出更大的框后回收进池
+    QVector<NodeItem*> pool_;
+    static constexpr int kPoolLimit = 512;
+    QTimer*   viewSyncTimer_{nullptr};
+    NodeItem* newNodeItem();                   // 只在这里连信号，槽里一律用 n->id()
+    void   recycleNodeItem(NodeItem* n);
+    void   scheduleViewSync();
+    void   syncVisibleNodes();
+
+    // 最近一次着色结果，新实体化的图元据此取角色
+    PersonId       roleCenter_{0};
+    QSet<PersonId> roleFriends_, roleSuggest_;
+    NodeItem::Role roleFor(PersonId id) const;
+    void   resetEdgeLayer();                   // scene_->clear() 之后重建空的边图层
     void   addEdge(PersonId a, PersonId b);
+    void   removeEdge(PersonId a, PersonId b);
+    QPointF randomFreePos(int maxTry = 80);
+
+    // 力导向布局：后台线程迭代，定时器按帧把中间结果搬进场景
+    ForceLayout* layout_{nullptr};
+    QTimer*      layoutTimer_{nullptr};
+    bool         applyingLayout_ = false;       // 正在把布局结果写进场景（不是用户拖动）
+    void   applyLayoutFrame();
+    void   finishLayout();                      // 停止、落盘、恢复按钮
+    void   onNodeDropped(NodeItem* n);          // 松手时若压住别人就挪到最近的空位
+
+    // 移动合并：x/yChanged 只登记 id，每帧统一同步一次坐标、网格和边
+    QHash<PersonId, bool> dirtyNodes_;          // id -> 是否由用户拖动（布局中需要 pin）
+    QTimer*      flushTimer_{nullptr};
+    void   markMoved(PersonId id);
+    void   flushMoved();
 
     // 简单环形布局：返回每个 id 的坐标
     QMap<PersonId, QPointF> radialPositions(const QPointF& center,
@@ -62,7 +118,28 @@ private:
     QString dataPath_;
     void saveToDisk();          // 退出时保存
     void showFullNetwork();
-    void refreshColorsAndInfo();
+    void clearScene();                     // 清空全部图元、边图层和网格
+    void redrawScene();                    // 按当前模式整体重画
+
+    // 个人视图：只画当前成员、部分好友和推荐，图元数与全网规模无关；
+    // 坐标只是临时的环形排布，不写回 graph_
+    bool   egoMode_ = false;
+    static constexpr int kEgoFriendLimit  = 48;
+    static constexpr int kEgoSuggestLimit = 12;
+    PersonId        egoRingCenter_ = 0;         // egoRing2_ 是以谁为中心算出来的
+    QList<PersonId> egoRing2_;                  // 外圈推荐：取自后台刷新结果，GUI 线程不算推荐
+    void   layoutEgoNetwork(PersonId center);   // 按当前 egoRing2_ 排布图元和边
+    QVariantAnimation* egoAnim_{nullptr};
+    QHash<PersonId, QPair<QPointF, QPointF>> egoMoves_;   // 重新居中时各节点的起止坐标
+    bool   egoRedrawQueued_ = false;
+    void   scheduleEgoRedraw();             // 同一轮事件里的多次变更只重画一次
+    void   stepEgoAnimation(qreal t);
+    void refreshColorsAndInfo();           // 异步：基于快照在线程池里算推荐
+
+    struct RefreshResult;
+    static RefreshResult computeRefresh(const SocialGraph::Snapshot& g, PersonId center);
+    void   applyRefresh(const RefreshResult& r);
+    quint64 refreshTicket_ = 0;            // 只应用最近一次请求的结果
     void updateInfoBox(PersonId center);   // ：刷新右侧信息面板
 
 
@@ -1,4 +1,5 @@
 #include "socialgraph.h"
+#include "compressedadjacency.h"
 #include <algorithm>
 #include <QFile>
 #include <QDir>
@@ -6,6 +7,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QStandardPaths>
+#include <QSignalBlocker>
 
 static inline bool isCustomType(GroupType t) {
     const int base = static_cast<int>(GroupType::Custom1);
@@ -21,10 +23,15 @@ SocialGraph::SocialGraph(QObject* parent) : QObject(parent) {}
 
 PersonId SocialGraph::addPerson(const Person& p)
 {
+    ensureExpanded();
     Person copy = p;
     copy.id = nextPersonId_++;
     persons.insert(copy.id, copy);
+    order_.push_back(copy.id);         // id 单调递增，追加即保持有序
     adj.insert(copy.id, {});           // 初始化空邻接
+    names_.insert(copy.id, copy.name);
+    touch();
+    emit personAdded(copy.id);
     return copy.id;
 }
 
@@ -36,12 +43,16 @@ bool SocialGraph::updatePerson(const Person& p)
     Person updated = p;
     updated.groups = kept.groups;
     persons[p.id] = updated;
+    if (kept.name != p.name) names_.insert(p.id, p.name);
+    touch();
+    emit personUpdated(p.id);
     return true;
 }
 
 bool SocialGraph::removePerson(PersonId id)
 {
     if (!checkPerson(id)) return false;
+    ensureExpanded();
 
     // 1) 从所有朋友那里移除这条无向边
     if (adj.contains(id)) {
@@ -66,6 +77,10 @@ bool SocialGraph::removePerson(PersonId id)
 
     // 4) 删人本体
     persons.remove(id);
+    order_.erase(std::lower_bound(order_.begin(), order_.end(), id));
+    names_.remove(id);
+    touch();
+    emit personRemoved(id);
     return true;
 }
 GroupId SocialGraph::addGroup(const Group& g)
@@ -74,6 +89,8 @@ GroupId SocialGraph::addGroup(const Group& g)
     copy.id = nextGroupId_++;
     groups.insert(copy.id, copy);
     groupIndex.insert(copy.id, {});
+    indexGroup(copy);
+    touch();
     return copy.id;
 }
 
@@ -84,7 +101,9 @@ bool SocialGraph::updateGroup(const Group& g)
     Group kept = groups.value(g.id);
     Group updated = g;
     groups[g.id] = updated;
-    Q_UNUSED(kept);
+    unindexGroup(kept);
+    indexGroup(updated);
+    touch();
     return true;
 }
 
@@ -95,24 +114,33 @@ bool SocialGraph::removeGroup(GroupId id)
     for (PersonId p : groupIndex.value(id))
         persons[p].groups.remove(id);
 
+    unindexGroup(groups.value(id));
     groupIndex.remove(id);
     groups.remove(id);
+    touch();
     return true;
 }
 
 bool SocialGraph::addFriendship(PersonId a, PersonId b)
 {
     if (a == b || !checkPerson(a) || !checkPerson(b)) return false;
+    ensureExpanded();
+    const bool fresh = !adj[a].contains(b);
     adj[a].insert(b);
     adj[b].insert(a);
+    touch();
+    if (fresh) emit friendshipAdded(a, b);
     return true;
 }
 
 bool SocialGraph::removeFriendship(PersonId a, PersonId b)
 {
     if (!checkPerson(a) || !checkPerson(b)) return false;
-    adj[a].remove(b);
+    ensureExpanded();
+    const bool existed = adj[a].remove(b);
     adj[b].remove(a);
+    touch();
+    if (existed) emit friendshipRemoved(a, b);
     return true;
 }
 
@@ -121,6 +149,7 @@ bool SocialGraph::addMembership(PersonId p, GroupId g)
     if (!checkPerson(p) || !checkGroup(g)) return false;
     persons[p].groups.insert(g);
     groupIndex[g].insert(p);
+    touch();
     return true;
 }
 
@@ -133,47 +162,73 @@ bool SocialGraph::removeMembership(PersonId p, GroupId g)
         groupIndex[g].remove(p);
         removeGroupIfEmpty(g);                //成员关系移除后，若人数为 0，删组
     }
+    touch();
     return true;
 }
-int SocialGraph::mutualFriends(PersonId a, PersonId b) const
+// —— 查询算法只读这三张表：现行图与快照共用同一份实现 ——
+namespace {
+struct Tables {
+    const SocialGraph::PersonTable& persons;
+    const SocialGraph::IdSetTable&  adj;
+    const SocialGraph::IdSetTable&  groupIndex;
+    const CompressedAdjacency*             packed;    // 非空时以它为准，adj 为空
+};
+
+QSet<PersonId> friendsIn(const Tables& t, PersonId id)
+{
+    return t.packed ? t.packed->neighbors(id) : t.adj.value(id);
+}
+
+template <typename Fn>
+void forEachFriendIn(const Tables& t, PersonId id, Fn&& fn)
 {
-    if (!checkPerson(a) || !checkPerson(b)) return 0;
-    const auto& A = adj.value(a);
-    const auto& B = adj.value(b);
+    if (t.packed) {
+        t.packed->forEachNeighbor(id, fn);       // 边解码边访问，不展开
+        return;
+    }
+    for (PersonId f : t.adj.value(id)) fn(f);
+}
+
+int mutualFriendsIn(const Tables& t, PersonId a, PersonId b)
+{
+    if (!t.persons.contains(a) || !t.persons.contains(b)) return 0;
+    if (t.packed) return t.packed->intersectCount(a, b);   // 两条有序流归并
+    const auto& A = t.adj.value(a);
+    const auto& B = t.adj.value(b);
     int count = 0;
     for (PersonId x : A) if (B.contains(x)) ++count;
     return count;
 }
 
-int SocialGraph::sharedGroups(PersonId a, PersonId b) const
+int sharedGroupsIn(const Tables& t, PersonId a, PersonId b)
 {
-    if (!checkPerson(a) || !checkPerson(b)) return 0;
-    const auto& A = persons.value(a).groups;
-    const auto& B = persons.value(b).groups;
+    if (!t.persons.contains(a) || !t.persons.contains(b)) return 0;
+    const auto& A = t.persons.value(a).groups;
+    const auto& B = t.persons.value(b).groups;
     int count = 0;
     for (GroupId g : A) if (B.contains(g)) ++count;
     return count;
 }
 
 QVector<SocialGraph::Suggestion>
-SocialGraph::potentialAcquaintances(PersonId source, int limit,
-                                    double wFriends, double wGroups) const
+potentialAcquaintancesIn(const Tables& t, PersonId source, int limit,
+                         double wFriends, double wGroups)
 {
-    QVector<Suggestion> out;
-    if (!checkPerson(source)) return out;
+    QVector<SocialGraph::Suggestion> out;
+    if (!t.persons.contains(source)) return out;
 
-    const auto& friends = adj.value(source);
+    const QSet<PersonId> friends = friendsIn(t, source);
 
     // 候选：好友的好友 + 同组织成员（集合并集）
     QSet<PersonId> candidates;
     for (PersonId f : friends) {
-        for (PersonId fof : adj.value(f)) {
+        forEachFriendIn(t, f, [&](PersonId fof){
             if (fof != source && !friends.contains(fof))
                 candidates.insert(fof);
-        }
+        });
     }
-    for (GroupId g : persons.value(source).groups) {
-        for (PersonId m : groupIndex.value(g)) {
+    for (GroupId g : t.persons.value(source).groups) {
+        for (PersonId m : t.groupIndex.value(g)) {
             if (m != source && !friends.contains(m))
                 candidates.insert(m);
         }
@@ -181,21 +236,21 @@ SocialGraph::potentialAcquaintances(PersonId source, int limit,
 
     out.reserve(candidates.size());
     for (PersonId c : candidates) {
-        int cf = mutualFriends(source, c);
+        int cf = mutualFriendsIn(t, source, c);
 
         // ★ 修改点 1：没有共同好友则直接忽略（“同组不算数”）
         if (cf <= 0) continue;
 
         // ★ 修改点 2：只有在 cf>0 时才计算/计入共同群组
-        int cg = sharedGroups(source, c);
+        int cg = sharedGroupsIn(t, source, c);
         double score = wFriends * cf + wGroups * cg;
 
-        out.push_back(Suggestion{c, cf, cg, score});
+        out.push_back(SocialGraph::Suggestion{c, cf, cg, score});
     }
 
     // 排序：score 降序 → commonFriends 降序 → commonGroups 降序
     std::sort(out.begin(), out.end(),
-              [](const Suggestion& a, const Suggestion& b){
+              [](const SocialGraph::Suggestion& a, const SocialGraph::Suggestion& b){
                   if (a.score != b.score) return a.score > b.score;
                   if (a.commonFriends != b.commonFriends) return a.commonFriends > b.commonFriends;
                   return a.commonGroups > b.commonGroups;
@@ -205,29 +260,132 @@ SocialGraph::potentialAcquaintances(PersonId source, int limit,
         out.resize(limit);
     return out;
 }
+} // namespace
+
+int SocialGraph::mutualFriends(PersonId a, PersonId b) const
+{
+    return mutualFriendsIn({persons, adj, groupIndex, packed_.get()}, a, b);
+}
+
+int SocialGraph::sharedGroups(PersonId a, PersonId b) const
+{
+    return sharedGroupsIn({persons, adj, groupIndex, packed_.get()}, a, b);
+}
+
+QVector<SocialGraph::Suggestion>
+SocialGraph::potentialAcquaintances(PersonId source, int limit,
+                                    double wFriends, double wGroups) const
+{
+    return potentialAcquaintancesIn({persons, adj, groupIndex, packed_.get()}, source, limit, wFriends, wGroups);
+}
+
+QSet<PersonId> SocialGraph::friendsOf(PersonId id) const
+{
+    return friendsIn({persons, adj, groupIndex, packed_.get()}, id);
+}
+
+QSet<PersonId> SocialGraph::Snapshot::friendsOf(PersonId id) const
+{
+    return friendsIn({persons, adj, groupIndex, packed.get()}, id);
+}
+
+int SocialGraph::Snapshot::mutualFriends(PersonId a, PersonId b) const
+{
+    return mutualFriendsIn({persons, adj, groupIndex, packed.get()}, a, b);
+}
+
+int SocialGraph::Snapshot::sharedGroups(PersonId a, PersonId b) const
+{
+    return sharedGroupsIn({persons, adj, groupIndex, packed.get()}, a, b);
+}
+
+QVector<SocialGraph::Suggestion>
+SocialGraph::Snapshot::potentialAcquaintances(PersonId source, int limit,
+                                              double wFriends, double wGroups) const
+{
+    return potentialAcquaintancesIn({persons, adj, groupIndex, packed.get()}, source, limit, wFriends, wGroups);
+}
+
+void SocialGraph::compactAdjacency(VertexOrder order)
+{
+    if (packed_) {
+        if (packed_->order() == order) return;
+        adj = IdSetTable::fromHash(packed_->expand());   // 换一种顺序重排：先还原再重新编码
+    }
+    packed_ = std::make_shared<const CompressedAdjacency>(CompressedAdjacency::build(adj.toHash(), order));
+    adj.clear();                                  // 释放 QSet 形式（快照若仍持有则由其保留）
+}
+
+void SocialGraph::expandAdjacency()
+{
+    if (!packed_) return;
+    adj = IdSetTable::fromHash(packed_->expand());
+    packed_.reset();
+}
+
+// 发布：各表拷贝只复制 256 个分片句柄（分片隐式共享）；之后写方第一次修改某个键时
+// 只分离它所在的那一片。界面每次编辑后都会取快照，所以不能让一次发布引起整表分离。
+SocialGraph::SnapshotPtr SocialGraph::snapshot() const
+{
+    if (published_ && published_->version == version_) return published_;
+
+    auto next = std::make_shared<Snapshot>();
+    next->version    = version_;
+    next->persons    = persons;
+    next->groups     = groups;
+    next->adj        = adj;
+    next->groupIndex = groupIndex;
+    next->packed     = packed_;                   // 压缩形式本身不可变，直接共享
+
+    published_ = std::move(next);
+    return published_;
+}
 
 void SocialGraph::clear()
 {
     persons.clear();
+    order_.clear();
     groups.clear();
     adj.clear();
     groupIndex.clear();
     positions.clear();
+    groupLookup_.clear();
+    names_.clear();
+    packed_.reset();
     nextPersonId_ = 1;
     nextGroupId_  = 1;
+    touch();
+    emit graphReset();
+}
+
+int SocialGraph::personRow(PersonId id) const
+{
+    const auto it = std::lower_bound(order_.cbegin(), order_.cend(), id);
+    return (it != order_.cend() && *it == id) ? int(it - order_.cbegin()) : -1;
+}
+
+void SocialGraph::reserve(int personCount)
+{
+    persons.reserve(personCount);
+    order_.reserve(personCount);
+    adj.reserve(personCount);
+    names_.reserve(personCount);
 }
 
 GroupId SocialGraph::ensureGroup(const QString& name, GroupType type)
 {
-    // 已存在就返回
-    for (auto it = groups.begin(); it != groups.end(); ++it) {
-        if (it.value().name == name && it.value().type == type)
-            return it.key();
+    // 已存在就返回（名字需完全一致）
+    const auto range = groupLookup_.equal_range(groupKey(name, type));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (groups.value(it.value()).name == name)
+            return it.value();
     }
     // 新建
     Group g; g.id = nextGroupId_++; g.name = name; g.type = type;
     groups.insert(g.id, g);
     groupIndex.insert(g.id, {});
+    indexGroup(g);
+    touch();
     return g.id;
 }
 
@@ -236,7 +394,9 @@ void SocialGraph::rebuildGroupsFromAttributes()
     // 清空旧组织（不动 persons/adj/positions）
     groups.clear();
     groupIndex.clear();
+    groupLookup_.clear();
     nextGroupId_ = 1;
+    touch();
 
     for (auto it = persons.begin(); it != persons.end(); ++it) {
         it.value().groups.clear();
@@ -306,16 +466,11 @@ bool SocialGraph::saveToFile(const QString& path) const
 
     // friendships（无向边，避免重复：只记录 a<b）
     QJsonArray arrEdges;
-    for (auto it = adj.begin(); it != adj.end(); ++it) {
-        const PersonId a = it.key();
-        for (PersonId b : it.value()) {
-            if (a < b) {
-                QJsonArray e;
-                e.append(QString::number(a));
-                e.append(QString::number(b));
-                arrEdges.append(e);
-            }
-        }
+    for (const auto& ab : allFriendEdges()) {
+        QJsonArray e;
+        e.append(QString::number(ab.first));
+        e.append(QString::number(ab.second));
+        arrEdges.append(e);
     }
     root["friendships"] = arrEdges;
 
@@ -342,6 +497,7 @@ bool SocialGraph::loadFromFile(const QString& path)
     if (err.error != QJsonParseError::NoError || !doc.isObject()) return false;
 
     QJsonObject root = doc.object();
+    QSignalBlocker quiet(this);           // 逐条的增删通知没有意义，结束时统一发 graphReset
     clear();
 
     // custom_titles（可选）
@@ -375,9 +531,13 @@ bool SocialGraph::loadFromFile(const QString& path)
 
         persons.insert(p.id, p);
         adj.insert(p.id, {});
+        names_.insert(p.id, p.name);
         if (p.id > maxId) maxId = p.id;
     }
     nextPersonId_ = maxId + 1;
+    order_.reserve(persons.size());
+    for (auto it = persons.cbegin(); it != persons.cend(); ++it) order_.push_back(it.key());
+    std::sort(order_.begin(), order_.end());
 
     // friendships
     const QJsonArray arrEdges = root.value("friendships").toArray();
@@ -392,11 +552,25 @@ bool SocialGraph::loadFromFile(const QString& path)
 
     // 基于 6 固定 + 5 自定义字段重建组织
     rebuildGroupsFromAttributes();
+    quiet.unblock();
+    emit graphReset();
     return true;
 }
 
 QVector<QPair<PersonId,PersonId>> SocialGraph::allFriendEdges() const {
     QVector<QPair<PersonId,PersonId>> es;
+    if (packed_) {
+        es.reserve(packed_->edgeCount());
+        for (quint32 s = 0; s < quint32(packed_->vertexCount()); ++s) {
+            const PersonId a = packed_->idAt(s);
+            auto c = packed_->cursorAt(s);
+            for (quint32 t; c.next(t); ) {
+                const PersonId b = packed_->idAt(t);
+                if (a < b) es.push_back({a,b});
+            }
+        }
+        return es;
+    }
     for (auto it = adj.begin(); it != adj.end(); ++it) {
         PersonId a = it.key();
         for (PersonId b : it.value()) {
@@ -421,12 +595,9 @@ GroupId SocialGraph::findOrCreateGroupByName(const QString& name, GroupType t)
     const QString n = name.trimmed();
     if (n.isEmpty()) return 0;
 
-    for (auto it = groups.begin(); it != groups.end(); ++it) {
-        if (it.value().type == t &&
-            it.value().name.compare(n, Qt::CaseInsensitive) == 0) {
-            return it.key();
-        }
-    }
+    // 按 (类型, 折叠名) 直接命中，不再线性扫描全部组织
+    auto it = groupLookup_.constFind(groupKey(n, t));
+    if (it != groupLookup_.cend()) return it.value();
     return ensureGroup(n, t);
 }
 
@@ -434,6 +605,7 @@ GroupId SocialGraph::findOrCreateGroupByName(const QString& name, GroupType t)
 void SocialGraph::setMembershipOfType(PersonId p, GroupType t, const QString& name)
 {
     if (!checkPerson(p)) return;
+    touch();
 
     // 旧组（同类最多一个）
     GroupId oldG = 0;
@@ -498,10 +670,144 @@ void SocialGraph::setMembershipOfType(PersonId p, GroupType t, const QString& na
 
 void SocialGraph::removeGroupIfEmpty(GroupId gid)
 {
-    auto it = groupIndex.find(gid);
-    if (it == groupIndex.end() || it.value().isEmpty()) {
+    const QSet<PersonId>* members = groupIndex.lookup(gid);
+    if (!members || members->isEmpty()) {
         groupIndex.remove(gid);
+        if (groups.contains(gid)) unindexGroup(groups.value(gid));
         groups.remove(gid);
     }
 }
 
+
+// —— 内存占用估算 ——
+namespace {
+// Qt6 QHash 布局：Data 头 + 每 128 个桶一个 Span（128 字节偏移表 + 条目指针/计数）+ 条目数组
+constexpr qint64 kHashHeader  = 48;          // QHashPrivate::Data
+constexpr qint64 kSpanBytes   = 128 + 16;    // offsets[128] + entries* + allocated/nextFree
+constexpr qint64 kArrayHeader = 16;          // QArrayData（引用计数、标志、容量）
+
+template <typename K, typename V>
+struct NodeOf { K key; V value; };
+
+qint64 tableBytes(qsizetype capacity, qsizetype size, qint64 nodeSize)
+{
+    if (capacity == 0) return 0;                 // 未分配（空表共享静态数据）
+    const qint64 spans = (qint64(capacity) + 127) / 128;
+    return kHashHeader + spans * kSpanBytes + qint64(size) * nodeSize;
+}
+
+template <typename K, typename V>
+qint64 hashBytes(const QHash<K, V>& h)
+{
+    return tableBytes(h.capacity(), h.size(), sizeof(NodeOf<K, V>));
+}
+
+template <typename K, typename V>
+qint64 hashBytes(const ShardedHash<K, V>& h)     // 分片数组 + 各片
+{
+    qint64 bytes = kArrayHeader + qint64(h.shards().capacity()) * qint64(sizeof(QHash<K, V>));
+    for (const auto& s : h.shards()) bytes += hashBytes(s);
+    return bytes;
+}
+
+template <typename T>
+qint64 setBytes(const QSet<T>& s)               // QSet 的节点只存 key
+{
+    return tableBytes(s.capacity(), s.size(), sizeof(T));
+}
+
+// 字符串负载：按数据指针去重，隐式共享的同一份只算一次
+struct StringBytes {
+    QSet<const void*> seen;
+    qint64 operator()(const QString& s) {
+        if (s.capacity() == 0) return 0;         // 空串或静态字面量
+        if (seen.contains(s.constData())) return 0;
+        seen.insert(s.constData());
+        return kArrayHeader + (qint64(s.capacity()) + 1) * qint64(sizeof(QChar));
+    }
+};
+
+QString formatBytes(double b)
+{
+    if (b >= 1024.0 * 1024.0) return QString::number(b / (1024.0 * 1024.0), 'f', 2) + " MiB";
+    if (b >= 1024.0)          return QString::number(b / 1024.0, 'f', 1) + " KiB";
+    return QString::number(b, 'f', 0) + " B";
+}
+} // namespace
+
+SocialGraph::MemoryReport SocialGraph::memoryReport() const
+{
+    MemoryReport r;
+    StringBytes str;
+    auto add = [&](const QString& name, qint64 bytes, qint64 entries){
+        r.components.push_back({name, bytes, entries});
+        r.totalBytes += bytes;
+    };
+
+    // 人员表：节点 + 12 个字符串字段 + 每人的组织集合
+    qint64 personStr = 0, personSets = 0;
+    for (const Person& p : persons) {
+        personStr += str(p.name) + str(p.region) + str(p.primarySchool) + str(p.middleSchool)
+                   + str(p.highSchool) + str(p.university) + str(p.company);
+        for (const QString& c : p.custom) personStr += str(c);
+        personSets += setBytes(p.groups);
+    }
+    add(QStringLiteral("人员表 persons"),         hashBytes(persons), persons.size());
+    add(QStringLiteral("人员字符串"),             personStr,           0);
+    add(QStringLiteral("人员所属组织集合"),       personSets,          0);
+    add(QStringLiteral("人员行号表 order_"),      qint64(order_.capacity()) * qint64(sizeof(PersonId)), order_.size());
+
+    qint64 groupStr = 0;
+    for (const Group& g : groups) groupStr += str(g.name) + str(g.desc);
+    add(QStringLiteral("组织表 groups（含字符串）"), hashBytes(groups) + groupStr, groups.size());
+
+    // 邻接表：外层哈希 + 每人一个好友集合
+    qint64 adjSets = 0, halfEdges = 0;
+    for (const auto& s : adj) { adjSets += setBytes(s); halfEdges += s.size(); }
+    r.edgeCount = halfEdges / 2;
+    add(QStringLiteral("邻接表 adj（外层）"),     hashBytes(adj), adj.size());
+    add(QStringLiteral("邻接表 adj（好友集合）"), adjSets,        halfEdges);
+    if (packed_) {
+        r.edgeCount = packed_->edgeCount();
+        add(QStringLiteral("压缩邻接表（id 映射）"), hashBytes(packed_->slotMap()), packed_->vertexCount());
+        add(QStringLiteral("压缩邻接表（编码数据）"), packed_->arrayBytes(),        packed_->edgeCount() * 2);
+    }
+
+    qint64 memberSets = 0, memberships = 0;
+    for (const auto& s : groupIndex) { memberSets += setBytes(s); memberships += s.size(); }
+    add(QStringLiteral("组织倒排 groupIndex（外层）"),   hashBytes(groupIndex), groupIndex.size());
+    add(QStringLiteral("组织倒排 groupIndex（成员集合）"), memberSets,           memberships);
+
+    add(QStringLiteral("坐标 positions"), hashBytes(positions), positions.size());
+    add(QStringLiteral("姓名索引（前缀树 + 倒排）"), names_.approxBytes(), names_.size());
+
+    // 组织名索引：QMultiHash 的节点存 key + 链表头，每个值一个链节点
+    qint64 lookupStr = 0;
+    for (auto it = groupLookup_.cbegin(); it != groupLookup_.cend(); ++it) lookupStr += str(it.key().second);
+    add(QStringLiteral("组织名索引"),
+        tableBytes(groupLookup_.capacity(), groupLookup_.uniqueKeys().size(),
+                   sizeof(GroupKey) + sizeof(void*))
+            + qint64(groupLookup_.size()) * qint64(sizeof(GroupId) + sizeof(void*))
+            + lookupStr,
+        groupLookup_.size());
+
+    r.personCount = persons.size();
+    return r;
+}
+
+QString SocialGraph::MemoryReport::toText() const
+{
+    QString out;
+    out += QStringLiteral("【内存占用估算】合计 %1\n").arg(formatBytes(double(totalBytes)));
+    for (const Component& c : components) {
+        const double pct = totalBytes ? 100.0 * double(c.bytes) / double(totalBytes) : 0.0;
+        out += QStringLiteral("  · %1：%2（%3%）").arg(c.name, formatBytes(double(c.bytes)))
+                   .arg(pct, 0, 'f', 1);
+        if (c.entries) out += QStringLiteral("，%1 项").arg(c.entries);
+        out += '\n';
+    }
+    out += QStringLiteral("\n成员 %1 人，好友边 %2 条\n").arg(personCount).arg(edgeCount);
+    out += QStringLiteral("每人 %1，每条边 %2\n")
+               .arg(formatBytes(bytesPerPerson()), formatBytes(bytesPerEdge()));
+    return out;
+}
@@ -8,9 +8,14 @@
 #include <QVector>
 #include <QString>
 #include <QSet>
+#include <QMultiHash>
 #include <QtGlobal>
 #include <QPointF>
 #include <QPair>
+#include <memory>
+#include "compressedadjacency.h"
+#include "nameindex.h"
+#include "shardedhash.h"
 
 
 using PersonId = quint64;
@@ -74,15 +79,8 @@ public:
     bool addMembership(PersonId p, GroupId g);
     bool removeMembership(PersonId p, GroupId g);
 
-    const Person* getPerson(PersonId id) const {
-        auto it = persons.constFind(id);
-        return it == persons.cend() ? nullptr : &it.value();   // value() 返回 const T&
-    }
-
-    const Group* getGroup(GroupId id) const {
-        auto it = groups.constFind(id);
-        return it == groups.cend() ? nullptr : &it.value();
-    }
+    const Person* getPerson(PersonId id) const { return persons.lookup(id); }
+    const Group*  getGroup(GroupId id) const   { return groups.lookup(id); }
 
     // --- 查询辅助 ---
     int  mutualFriends(PersonId a, PersonId b) const;   // 共同好友数
@@ -102,10 +100,73 @@ public:
                                                double wFriends = 1.0,
                                                double wGroups  = 1.0) const;
 
+    // --- 多版本只读快照（RCU 风格）---
+    // 写操作只改现行容器并递增版本号；snapshot() 按需把各表以隐式共享的方式
+    // “拷贝”成一个不可变版本（同一版本内重复调用返回同一个）。图所在线程取到
+    // SnapshotPtr 后按值交给工作线程，持有者即得到一致视图，最后一个持有者释放时该版本自动回收。
+    // 各表是 256 片的 ShardedHash：发布只复制分片数组，发布后的下一次编辑
+    // 只分离被写的那一片，而不是整表复制。
+    using PersonTable = ShardedHash<PersonId, Person>;
+    using GroupTable  = ShardedHash<GroupId,  Group>;
+    using IdSetTable  = ShardedHash<quint64,  QSet<PersonId>>;   // 人 -> 好友 / 组织 -> 成员
+
+    struct Snapshot
+    {
+        quint64 version = 0;
+        PersonTable persons;
+        GroupTable  groups;
+        IdSetTable  adj;
+        IdSetTable  groupIndex;
+        std::shared_ptr<const CompressedAdjacency> packed;   // 发布时若为压缩形式则 adj 为空
+
+        const Person* getPerson(PersonId id) const { return persons.lookup(id); }
+        const Group*  getGroup(GroupId id) const   { return groups.lookup(id); }
+        QSet<PersonId> friendsOf(PersonId id) const;
+
+        int mutualFriends(PersonId a, PersonId b) const;
+        int sharedGroups (PersonId a, PersonId b) const;
+        QVector<Suggestion> potentialAcquaintances(PersonId source,
+                                                   int limit = -1,
+                                                   double wFriends = 1.0,
+                                                   double wGroups  = 1.0) const;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    SnapshotPtr snapshot() const;            // 只在图所在线程调用：版本过期时发布新版本
+    quint64     version() const { return version_; }
+
+    // --- 内存占用估算 ---
+    // 按 Qt6 QHash 的实际布局（span 桶数组 + 节点）估算各容器字节数，
+    // 含哈希桶开销、字符串负载（隐式共享的只算一次）和每个好友/成员集合自身的桶。
+    struct MemoryReport
+    {
+        struct Component {
+            QString name;
+            qint64  bytes   = 0;
+            qint64  entries = 0;
+        };
+        QVector<Component> components;
+        qint64 totalBytes  = 0;
+        qint64 personCount = 0;
+        qint64 edgeCount   = 0;
+
+        double  bytesPerPerson() const { return personCount ? double(totalBytes) / personCount : 0.0; }
+        double  bytesPerEdge()   const { return edgeCount   ? double(totalBytes) / edgeCount   : 0.0; }
+        QString toText() const;      // 多行文本，供 GUI 面板和命令行输出
+    };
+    MemoryReport memoryReport() const;
+
+    // --- 邻接表存储形式 ---
+    // 压缩形式（排序 + 差分 + group varint）只读，占用约为 QSet 形式的 1/4；
+    // 查询直接在压缩流上进行；增删成员、增删好友的写操作会先自动展开。
+    // order 决定内部存储顺序（默认 RCM，好友序号相近、遍历局部性好），PersonId 不受影响。
+    using VertexOrder = CompressedAdjacency::VertexOrder;
+    void compactAdjacency(VertexOrder order = VertexOrder::ReverseCuthillMcKee);
+    void expandAdjacency();
+    bool isAdjacencyCompact() const { return packed_ != nullptr; }
+
     // 便于 UI：取某人全部好友
-    QSet<PersonId> friendsOf(PersonId id) const {
-        return adj.contains(id) ? adj.value(id) : QSet<PersonId>{};
-    }
+    QSet<PersonId> friendsOf(PersonId id) const;
 
     // 便于 UI：取某组织的全部成员
     QSet<PersonId> membersOf(GroupId gid) const {
@@ -117,6 +178,14 @@ public:
     bool loadFromFile(const QString& path);
     void rebuildGroupsFromAttributes();  // 仅用 5 类字段还原组织
     QList<PersonId> allPersons() const { return persons.keys(); }
+    // 按姓名查人（前缀 + 子串，忽略大小写），结果已按相关度排序
+    QVector<PersonId> searchPersons(const QString& query, int limit = 200) const {
+        return names_.search(query, limit);
+    }
+    int  personCount() const { return persons.size(); }
+    PersonId personAt(int row) const { return order_[row]; }   // 0 <= row < personCount()，按 id 升序
+    int      personRow(PersonId id) const;                     // personAt 的逆，不存在返回 -1
+    void reserve(int personCount);                   // 批量导入前预留哈希容量
 
     // 节点位置的存取
     void     setPosition(PersonId id, const QPointF& p) { positions[id] = p; }
@@ -141,15 +210,43 @@ public:
     QStringList allCustomTitles() const { return customTitles_; }
 
 
+signals:
+    // 结构变更通知（同步发出），供界面增量更新；批量导入/加载时可用 QSignalBlocker 屏蔽，
+    // 结束后由 graphReset 或调用方整体重绘
+    void personAdded(PersonId id);
+    void personRemoved(PersonId id);                  // 其好友边随之消失，不再逐条通知
+    void personUpdated(PersonId id);
+    void friendshipAdded(PersonId a, PersonId b);
+    void friendshipRemoved(PersonId a, PersonId b);
+    void graphReset();                                // clear / loadFromFile 之后
+
 private:
-    QHash<PersonId, QPointF> positions; // 新增：节点坐标
+    QHash<PersonId, QPointF> positions; // 新增：节点坐标（不进快照）
+    quint64 version_ = 0;                       // 每次结构/属性修改 +1
+    mutable SnapshotPtr published_;             // 最近一次发布的版本，只在图所在线程读写
+    void touch() { ++version_; }
+
+    std::shared_ptr<const CompressedAdjacency> packed_;  // 非空时 adj 为空
+    void ensureExpanded() { if (packed_) expandAdjacency(); }
+
     PersonId nextPersonId_ = 1;
     GroupId  nextGroupId_  = 1;
 
-    QHash<PersonId, Person> persons;                   // 人节点
-    QHash<GroupId,  Group>  groups;                    // 组织
-    QHash<PersonId, QSet<PersonId>> adj;               // 邻接表（好友）
-    QHash<GroupId,  QSet<PersonId>> groupIndex;        // 组织 -> 成员 倒排
+    PersonTable persons;                               // 人节点
+    GroupTable  groups;                                // 组织
+    IdSetTable  adj;                                   // 邻接表（好友）
+    IdSetTable  groupIndex;                            // 组织 -> 成员 倒排
+    NameIndex names_;                                  // 姓名 -> 人员（随增删改同步）
+    QVector<PersonId> order_;                          // 现有 PersonId 升序：行号 -> id，列表按需取行
+
+    // (类型, 折叠大小写后的名字) -> 组织；同名不同大小写的组织可能有多个
+    using GroupKey = QPair<quint8, QString>;
+    QMultiHash<GroupKey, GroupId> groupLookup_;
+    static GroupKey groupKey(const QString& name, GroupType type) {
+        return { static_cast<quint8>(type), name.toCaseFolded() };
+    }
+    void indexGroup  (const Group& g) { groupLookup_.insert(groupKey(g.name, g.type), g.id); }
+    void unindexGroup(const Group& g) { groupLookup_.remove(groupKey(g.name, g.type), g.id); }
 
     bool checkPerson(PersonId id) const { return persons.contains(id); }
     bool checkGroup (GroupId  id) const { return groups.contains(id); }
@@ -0,0 +1,178 @@
+#include "spatialgrid.h"
+#include <QRandomGenerator>
+#include <QtMath>
+#include <QPoint>
+
+namespace {
+// 第 k 圈（k>0）外框上的第 t 个格点（0 <= t < 8k），沿四条边依次排列
+QPoint ringPoint(int k, int t)
+{
+    if (k == 0) return QPoint(0, 0);
+    const int side = t / (2 * k), o = t % (2 * k);
+    switch (side) {
+    case 0:  return QPoint(-k + o, -k);
+    case 1:  return QPoint(k, -k + o);
+    case 2:  return QPoint(k - o, k);
+    default: return QPoint(-k, k - o);
+    }
+}
+} // namespace
+
+void SpatialGrid::clear()
+{
+    cells_.clear();
+    pos_.clear();
+    spiralRing_ = 0;
+    spiralStep_ = 0;
+    saturated_  = false;
+    ++version_;
+}
+
+void SpatialGrid::insert(PersonId id, const QPointF& p)
+{
+    if (pos_.contains(id)) { move(id, p); return; }
+    pos_.insert(id, p);
+    cells_[key(cellOf(p.x()), cellOf(p.y()))].push_back(id);
+    ++version_;
+}
+
+void SpatialGrid::remove(PersonId id)
+{
+    auto it = pos_.find(id);
+    if (it == pos_.end()) return;
+    const quint64 k = key(cellOf(it->x()), cellOf(it->y()));
+    pos_.erase(it);
+    saturated_ = false;                      // 腾出了位置，下次先随机试
+    ++version_;
+
+    auto c = cells_.find(k);
+    if (c == cells_.end()) return;
+    c->removeOne(id);
+    if (c->isEmpty()) cells_.erase(c);
+}
+
+void SpatialGrid::move(PersonId id, const QPointF& p)
+{
+    auto it = pos_.find(id);
+    if (it == pos_.end()) { insert(id, p); return; }
+    if (*it == p) return;
+    ++version_;
+
+    const quint64 from = key(cellOf(it->x()), cellOf(it->y()));
+    const quint64 to   = key(cellOf(p.x()),   cellOf(p.y()));
+    *it = p;
+    if (from == to) return;                  // 拖动时多数情况仍在同一格
+
+    auto c = cells_.find(from);
+    if (c != cells_.end()) {
+        c->removeOne(id);
+        if (c->isEmpty()) cells_.erase(c);
+    }
+    cells_[to].push_back(id);
+}
+
+void SpatialGrid::pointsIn(const QRectF& r, QVector<QPointF>& out) const
+{
+    forEachIn(r, [&](PersonId, const QPointF& p){ out.push_back(p); });
+}
+
+void SpatialGrid::idsIn(const QRectF& r, QVector<PersonId>& out) const
+{
+    forEachIn(r, [&](PersonId id, const QPointF&){ out.push_back(id); });
+}
+
+QRectF SpatialGrid::bounds() const
+{
+    if (pos_.isEmpty()) return QRectF();
+    qreal x0 = pos_.cbegin()->x(), y0 = pos_.cbegin()->y(), x1 = x0, y1 = y0;
+    for (const QPointF& p : pos_) {
+        x0 = qMin(x0, p.x()); x1 = qMax(x1, p.x());
+        y0 = qMin(y0, p.y()); y1 = qMax(y1, p.y());
+    }
+    return QRectF(QPointF(x0, y0), QPointF(x1, y1));
+}
+
+bool SpatialGrid::anyWithin(const QPointF& p, qreal r, PersonId exclude) const
+{
+    const int x0 = cellOf(p.x() - r), x1 = cellOf(p.x() + r);
+    const int y0 = cellOf(p.y() - r), y1 = cellOf(p.y() + r);
+    const qreal r2 = r * r;
+    for (int cx = x0; cx <= x1; ++cx) {
+        for (int cy = y0; cy <= y1; ++cy) {
+            auto c = cells_.constFind(key(cx, cy));
+            if (c == cells_.cend()) continue;
+            for (PersonId id : *c) {
+                if (id == exclude) continue;
+                const QPointF d = pos_.value(id) - p;
+                if (d.x() * d.x() + d.y() * d.y() < r2) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// 按格子环逐圈向外：第 k 圈上的点距离至少 (k-1)*cell，超过当前最优即可停
+PersonId SpatialGrid::nearest(const QPointF& p, qreal maxDist, PersonId exclude) const
+{
+    const int cx = cellOf(p.x()), cy = cellOf(p.y());
+    const int maxRing = int(qCeil(maxDist / cell_)) + 1;
+    PersonId best = 0;
+    qreal bestD2 = maxDist * maxDist;
+
+    for (int k = 0; k <= maxRing; ++k) {
+        const qreal ringDist = qreal(k - 1) * cell_;
+        if (best && k >= 2 && ringDist * ringDist > bestD2) break;
+        const int perimeter = k == 0 ? 1 : 8 * k;
+        for (int t = 0; t < perimeter; ++t) {
+            const QPoint g = ringPoint(k, t);
+            auto c = cells_.constFind(key(cx + g.x(), cy + g.y()));
+            if (c == cells_.cend()) continue;
+            for (PersonId id : *c) {
+                if (id == exclude) continue;
+                const QPointF d = pos_.value(id) - p;
+                const qreal d2 = d.x() * d.x() + d.y() * d.y();
+                if (d2 <= bestD2) { bestD2 = d2; best = id; }
+            }
+        }
+    }
+    return best;
+}
+
+QPointF SpatialGrid::freePosition(const QRectF& world, qreal minDist, int maxTry)
+{
+    if (!saturated_) {
+        auto* rng = QRandomGenerator::global();
+        for (int k = 0; k < maxTry; ++k) {
+            const QPointF p(world.left() + rng->bounded(world.width()),
+                            world.top()  + rng->bounded(world.height()));
+            if (!anyWithin(p, minDist)) return p;
+        }
+        saturated_ = true;
+    }
+
+    // world 已经挤满：以 world 中心为原点，按 minDist 的步长逐圈向外找空位，
+    // 从上次停下的位置接着走（返回的点随后会被插入，不必再看）
+    const QPointF c = world.center();
+    for (;;) {
+        const int perimeter = spiralRing_ == 0 ? 1 : 8 * spiralRing_;
+        while (spiralStep_ < perimeter) {
+            const QPoint g = ringPoint(spiralRing_, spiralStep_++);
+            const QPointF p(c.x() + g.x() * minDist, c.y() + g.y() * minDist);
+            if (!anyWithin(p, minDist * 0.999)) return p;
+        }
+        ++spiralRing_;
+        spiralStep_ = 0;
+    }
+}
+
+QPointF SpatialGrid::freePositionNear(const QPointF& p, qreal minDist, PersonId exclude) const
+{
+    if (!anyWithin(p, minDist, exclude)) return p;
+    for (int k = 1; ; ++k) {
+        for (int t = 0; t < 8 * k; ++t) {
+            const QPoint g = ringPoint(k, t);
+            const QPointF q(p.x() + g.x() * minDist, p.y() + g.y() * minDist);
+            if (!anyWithin(q, minDist * 0.999, exclude)) return q;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// spatialgrid.h
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+#include <QtMath>
+
+using PersonId = quint64;
+
+/**
+ * 节点坐标的均匀网格索引（格子边长 ≈ 节点最小间距）：
+ * - 插入/删除/移动 O(1)；
+ * - 半径查询只看覆盖到的几个格子，最近邻按格子环逐圈向外找；
+ * - freePosition：先在 world 内随机试点（每次检查 O(1)），
+ *   world 放满后沿网格螺旋向外找空位，并记住螺旋走到的位置，不会反复从中心扫起。
+ * PersonId 从 1 开始，0 用作“无 / 不排除”。
+ */
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(qreal cellSize = 90.0) : cell_(cellSize) {}
+
+    void clear();
+    void reserve(int count) { pos_.reserve(count); cells_.reserve(count); }
+
+    void insert(PersonId id, const QPointF& p);
+    void remove(PersonId id);
+    void move(PersonId id, const QPointF& p);
+
+    bool     contains(PersonId id) const { return pos_.contains(id); }
+    int      size() const { return int(pos_.size()); }
+    PersonId nearest(const QPointF& p, qreal maxDist, PersonId exclude = 0) const;   // 找不到返回 0
+    bool     anyWithin(const QPointF& p, qreal r, PersonId exclude = 0) const;
+    void     pointsIn(const QRectF& r, QVector<QPointF>& out) const;               // 追加到 out
+    void     idsIn(const QRectF& r, QVector<PersonId>& out) const;                 // 追加到 out
+    QRectF   bounds() const;                                                      // 全部点的外包矩形，O(n)
+    quint64  version() const { return version_; }                                 // 任一点增删或移动都会变
+
+    QPointF  freePosition(const QRectF& world, qreal minDist, int maxTry = 80);
+    QPointF  freePositionNear(const QPointF& p, qreal minDist, PersonId exclude = 0) const;
+
+    static quint64 key(int cx, int cy) { return (quint64(quint32(cx)) << 32) | quint32(cy); }   // 格子编码，EdgeLayer 分桶也用
+
+private:
+    int cellOf(qreal v) const { return int(qFloor(v / cell_)); }
+
+    // 区域覆盖的格子比非空格子还多时（缩得很小的视图），直接遍历非空格子
+    template <typename Fn>
+    void forEachIn(const QRectF& r, Fn fn) const
+    {
+        const int x0 = cellOf(r.left()), x1 = cellOf(r.right());
+        const int y0 = cellOf(r.top()),  y1 = cellOf(r.bottom());
+        const qint64 span = qint64(x1 - x0 + 1) * qint64(y1 - y0 + 1);
+
+        auto take = [&](const QVector<PersonId>& ids){
+            for (PersonId id : ids) {
+                const QPointF p = pos_.value(id);
+                if (r.contains(p)) fn(id, p);
+            }
+        };
+        if (span > qint64(cells_.size())) {
+            for (const auto& c : cells_) take(c);
+            return;
+        }
+        for (int cx = x0; cx <= x1; ++cx) {
+            for (int cy = y0; cy <= y1; ++cy) {
+                auto c = cells_.constFind(key(cx, cy));
+                if (c != cells_.cend()) take(*c);
+            }
+        }
+    }
+
+    qreal cell_;
+    QHash<quint64, QVector<PersonId>> cells_;
+    QHash<PersonId, QPointF>          pos_;
+    int  spiralRing_ = 0;                    // 螺旋兜底走到的圈 / 圈内序号，之前的点都已占用
+    int  spiralStep_ = 0;
+    bool saturated_  = false;                // world 内随机试点已失败过：直接走螺旋
+    quint64 version_ = 0;
+};